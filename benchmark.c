@@ -0,0 +1,259 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The benchmark program, it times the parts of the fish feeder that the performance work is aimed at:
+* the cost of each hardware command by type, drawing the splash screen, redrawing the menus and main screen, the
+* schedule functions at every schedule size and saving to and loading from the EEPROM image.
+*
+* It is built against the headless hardware functions as 'fishBenchmark', and against the GUI as 'fishBenchmarkGui'
+* when the FISH_BENCHMARK_GUI option is on. Each result is printed as one line of JSON so results can be compared
+* across commits, running it with '--output <file>' writes them to a file instead.
+*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "displayScreens.h"
+#include "eepromImage.h"
+#include "fish.h"
+#include "graphicsState.h"
+#include "menusFunctions.h"
+#include "operatingMode.h"
+#include "programShutdown.h"
+#include "programStartup.h"
+#include "timerWheel.h"
+#include "benchmarkCommit.h" //Generated on every build by benchmarkCommit.cmake.
+
+#ifdef BENCHMARK_GUI
+#define BENCHMARK_BACKEND "gui"
+#else
+#define BENCHMARK_BACKEND "headless"
+#endif
+#define BENCHMARK_MAX_SAMPLES 20000
+#define BENCHMARK_EEPROM_FILE "benchmarkEEPROM.bin"
+
+static FILE *output; //Where the results are written.
+static long long samples[BENCHMARK_MAX_SAMPLES];
+static operatingModeStruct benchmarkMode; //The operating mode the benchmarks work on.
+
+/**
+ * @return Nanoseconds from a clock that never jumps.
+ */
+static long long monotonicNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/**
+ * Custom function for qsort that orders samples from smallest to largest.
+ *
+ * @param value1 A pointer to the first sample.
+ * @param value2 A pointer to the second sample.
+ * @return Negative if the first sample is smaller, positive if it is larger and 0 if they are equal.
+ */
+static int compareSamples(const void *value1, const void *value2) {
+    const long long sample1 = *(const long long *) value1;
+    const long long sample2 = *(const long long *) value2;
+    return (sample1 > sample2) - (sample1 < sample2);
+}
+
+/**
+ * Times a function a number of times and writes the result as one line of JSON.
+ *
+ * @param name The name of the benchmark.
+ * @param parameter A size the benchmark was run at, or -1 if it doesn't have one.
+ * @param iterations How many times the function is timed, at most BENCHMARK_MAX_SAMPLES.
+ * @param function The function being timed.
+ */
+static void runBenchmark(const char *name, const int parameter, int iterations, void (*function)()) {
+    if (iterations > BENCHMARK_MAX_SAMPLES) {
+        iterations = BENCHMARK_MAX_SAMPLES;
+    }
+    function(); //Warms up the caches and anything opened on first use.
+    displayFlush();
+    long long totalNs = 0;
+    for (int i = 0; i < iterations; i++) {
+        const long long startNs = monotonicNs();
+        function();
+        displayFlush(); //Commands are sent in the background, so the time includes them reaching the hardware.
+        samples[i] = monotonicNs() - startNs;
+        totalNs += samples[i];
+    }
+    qsort(samples, (size_t) iterations, sizeof(long long), compareSamples);
+    fprintf(output, "{\"commit\":\"%s\",\"backend\":\"%s\",\"benchmark\":\"%s\",\"parameter\":%d,"
+            "\"iterations\":%d,\"meanNs\":%.1f,\"minNs\":%lld,\"p50Ns\":%lld,\"p99Ns\":%lld,\"maxNs\":%lld}\n",
+            BENCHMARK_COMMIT, BENCHMARK_BACKEND, name, parameter, iterations, (double) totalNs / iterations,
+            samples[0], samples[iterations / 2], samples[(iterations - 1) * 99 / 100], samples[iterations - 1]);
+    fflush(output);
+}
+
+//HARDWARE COMMANDS, one of each command type.
+static void commandClear() {
+    displayClear();
+}
+
+static void commandColour() {
+    displayColour("white", "50cae0");
+}
+
+static void commandText() {
+    displayText(10, 10, "Config menu:", 1);
+}
+
+static void commandPixel() {
+    displayPixel(64, 32);
+}
+
+static void commandLine() {
+    displayLine(0, 10, 127, 10);
+}
+
+static void commandClearArea() {
+    displayClearArea(0, 0, 64, 32);
+}
+
+static void commandFood() {
+    foodFill(50);
+}
+
+static void commandMotorStep() {
+    motorStep();
+}
+
+static void messageButton() {
+    free(buttonState());
+}
+
+static void messageClock() {
+    clockSecond();
+}
+
+//SCREENS
+/**
+ * Draws every frame of the splash screen the way the program does, the frames are decoded before the benchmarks run.
+ */
+static void renderSplash() {
+    for (int i = 0; i < SPLASH_FRAMES; i++) {
+        displaySplashFrame(i);
+    }
+}
+
+static void renderConfigurationMenu() {
+    displayConfigurationMenu(1);
+}
+
+static void renderMainScreen() {
+    displayMainScreen(&benchmarkMode);
+}
+
+//SCHEDULE FUNCTIONS
+static void scheduleFindNextFeed() {
+    findNextFeed(&benchmarkMode);
+}
+
+/**
+ * Puts the schedule in reverse order before sorting it, so each sort does the same work.
+ */
+static void scheduleSort() {
+    for (int i = 0; i < benchmarkMode.numberOfFeedsInADay / 2; i++) {
+        const timeStruct swap = benchmarkMode.feedTimes[i];
+        benchmarkMode.feedTimes[i] = benchmarkMode.feedTimes[benchmarkMode.numberOfFeedsInADay - 1 - i];
+        benchmarkMode.feedTimes[benchmarkMode.numberOfFeedsInADay - 1 - i] = swap;
+    }
+    sortScheduleTimes(&benchmarkMode);
+}
+
+/**
+ * Sets the benchmark operating mode to a schedule of a number of feeds spread over the day.
+ *
+ * @param numberOfFeeds How many feeds the schedule has, between 0 and 9.
+ */
+static void makeSchedule(const int numberOfFeeds) {
+    timeStruct feeds[9];
+    for (int i = 0; i < 9; i++) {
+        initialiseTime(&feeds[i], (i * 24 / 9 + 1) % 24, (i * 7) % 60, i % 9 + 1);
+    }
+    initialiseOperatingMode(&benchmarkMode, 0, 0, numberOfFeeds, feeds, 12);
+}
+
+//PERSISTENCE
+/**
+ * Changes the auto feeds done before saving, a save of an unchanged operating mode writes nothing so every save must
+ * have something to write.
+ */
+static void persistenceSave() {
+    benchmarkMode.autoFeedsDone ^= 1;
+    saveToEEPROM(BENCHMARK_EEPROM_FILE, &benchmarkMode);
+}
+
+static void persistenceLoad() {
+    loadFromEEPROM(BENCHMARK_EEPROM_FILE, &benchmarkMode);
+}
+
+/**
+ * Runs every benchmark, this is called on the processing thread once the hardware is ready.
+ */
+void userProcessing() {
+    initialiseTimerWheel(&programTimers);
+    clockSet(0, 0, 14, 1, 1, 1970);
+    makeSchedule(9);
+
+    runBenchmark("command.CLEAR_DISPLAY", -1, 2000, commandClear);
+    runBenchmark("command.COLOUR", -1, 2000, commandColour);
+    runBenchmark("command.TEXTXY", -1, 2000, commandText);
+    runBenchmark("command.PIXEL", -1, 2000, commandPixel);
+    runBenchmark("command.LINE", -1, 2000, commandLine);
+    runBenchmark("command.CLEAR_AREA", -1, 2000, commandClearArea);
+    runBenchmark("command.FOOD", -1, 2000, commandFood);
+    runBenchmark("command.MOTOR_STEP", -1, 2000, commandMotorStep);
+    runBenchmark("message.BUTTON", -1, 2000, messageButton);
+    runBenchmark("message.RTC_SECOND", -1, 2000, messageClock);
+
+    graphicsForget(&programGraphics); //The commands above drew without the graphics state knowing.
+    decodeSplashScreen(); //Done by the startup pipeline before the splash screen is shown.
+    runBenchmark("render.splashScreen", -1, 5, renderSplash);
+    runBenchmark("render.configurationMenu", -1, 200, renderConfigurationMenu);
+    runBenchmark("render.mainScreen", -1, 200, renderMainScreen);
+
+    for (int numberOfFeeds = 1; numberOfFeeds <= 9; numberOfFeeds++) {
+        makeSchedule(numberOfFeeds);
+        runBenchmark("schedule.findNextFeed", numberOfFeeds, 2000, scheduleFindNextFeed);
+        runBenchmark("schedule.sortScheduleTimes", numberOfFeeds, 2000, scheduleSort);
+    }
+
+    makeSchedule(9);
+    unlink(BENCHMARK_EEPROM_FILE); //Every run starts with a new image.
+    runBenchmark("persistence.saveToEEPROM", -1, 200, persistenceSave);
+    runBenchmark("persistence.loadFromEEPROM", -1, 200, persistenceLoad);
+    closeEEPROMImage(&programEEPROM);
+    unlink(BENCHMARK_EEPROM_FILE);
+}
+
+/**
+ * The entry point of the benchmark program.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments, '--output <file>' writes the results to the file.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if the results file can't be created.
+ */
+int main(int argc, char *argv[]) {
+    output = stdout;
+    if (argc == 3 && strcmp(argv[1], "--output") == 0) {
+        output = fopen(argv[2], "w");
+        if (output == NULL) {
+            printf("%s can't be created\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (jniSetup() != 0) {
+        return EXIT_FAILURE;
+    }
+    javaFx(); //Returns straight away on the headless hardware.
+    if (output != stdout) {
+        fclose(output);
+    }
+    return EXIT_SUCCESS;
+}
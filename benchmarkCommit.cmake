@@ -0,0 +1,14 @@
+#Writes the commit being built to benchmarkCommit.h, run at build time so a rebuild without reconfiguring still stamps
+#the benchmark results with the current commit. The header is only rewritten when the commit changes.
+execute_process(COMMAND git rev-parse --short HEAD WORKING_DIRECTORY ${SOURCE_DIR}
+        OUTPUT_VARIABLE BENCHMARK_COMMIT OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+if (NOT BENCHMARK_COMMIT)
+    set(BENCHMARK_COMMIT unknown)
+endif ()
+set(CONTENTS "#define BENCHMARK_COMMIT \"${BENCHMARK_COMMIT}\"\n")
+if (EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} EXISTING)
+endif ()
+if (NOT "${CONTENTS}" STREQUAL "${EXISTING}")
+    file(WRITE ${OUTPUT} "${CONTENTS}")
+endif ()
@@ -0,0 +1,38 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The feeders clock offset, read from the clock once and kept until the clock is set.
+*/
+#include <pthread.h>
+#include <stdbool.h>
+#include "clockOffset.h"
+#include "fish.h"
+
+static pthread_mutex_t offsetLock = PTHREAD_MUTEX_INITIALIZER;
+static bool offsetKnown = false;
+static long long offset;
+
+/**
+ * Gets the clocks offset from real time, only the first call after the clock is set asks the clock.
+ *
+ * @return The warm start value of the clock.
+ */
+long long clockOffset(void) {
+    pthread_mutex_lock(&offsetLock);
+    if (!offsetKnown) {
+        offset = clockWarmStart(0);
+        offsetKnown = true;
+    }
+    const long long result = offset;
+    pthread_mutex_unlock(&offsetLock);
+    return result;
+}
+
+/**
+ * Forgets the offset, this must be called whenever the clock is set.
+ */
+void clockOffsetChanged(void) {
+    pthread_mutex_lock(&offsetLock);
+    offsetKnown = false;
+    pthread_mutex_unlock(&offsetLock);
+}
@@ -0,0 +1,16 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the feeders clock offset, how far the feeders clock is from real time, read from the clock once.
+*
+* The clock keeps running with real time so its offset only changes when the clock is set. Reading every field of the
+* clock is a round trip to the GUI for each field, and the fields can tear when the clock passes a minute or a day
+* between two reads. Anything that only needs the time as a number adds the offset to the time instead, one read of
+* real time that can't tear. Anything that sets the clock calls clockOffsetChanged so the offset is read again.
+*/
+#ifndef CLOCK_OFFSET_HEADER
+#define CLOCK_OFFSET_HEADER
+
+long long clockOffset(void); //The warm start value of the clock, read from the clock the first time it is needed.
+void clockOffsetChanged(void); //The clock has been set, the offset is read again next time.
+#endif //CLOCK_OFFSET_HEADER
@@ -0,0 +1,297 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* Recording the hardware command stream and replaying it.
+*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "commandRecorder.h"
+#include "fish.h"
+#include "timerWheel.h"
+
+commandRecorderStruct programRecorder = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0};
+
+/**
+ * Writes a number 7 bits at a time, the top bit of each byte says if another byte follows.
+ *
+ * @param file The file written to.
+ * @param value The number.
+ */
+static void writeVarint(FILE *file, uint64_t value) {
+    while (value >= 0x80) {
+        putc((int) (value & 0x7F) | 0x80, file);
+        value >>= 7;
+    }
+    putc((int) value, file);
+}
+
+/**
+ * Reads a number written by writeVarint.
+ *
+ * @param file The file read from.
+ * @param value Set to the number.
+ * @return False if the file ended part way through the number.
+ */
+static bool readVarint(FILE *file, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const int byte = getc(file);
+        if (byte == EOF) {
+            return false;
+        }
+        *value |= (uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Starts recording to a file, any file with the same name is replaced.
+ *
+ * @param recorder The recorder.
+ * @param filename The name of the recording.
+ * @return If the file could be created.
+ */
+bool openCommandRecorder(commandRecorderStruct *recorder, const char *filename) {
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL) {
+        printf("Command recorder: %s can't be created\n", filename);
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 16); //Records are small so they are written in large blocks.
+    const uint32_t magic = COMMAND_RECORDING_MAGIC;
+    const uint16_t version = COMMAND_RECORDING_VERSION;
+    fwrite(&magic, sizeof(magic), 1, file);
+    fwrite(&version, sizeof(version), 1, file);
+    pthread_mutex_lock(&recorder->lock);
+    recorder->file = file;
+    recorder->previousUs = monotonicUs();
+    recorder->records = 0;
+    pthread_mutex_unlock(&recorder->lock);
+    return true;
+}
+
+/**
+ * @param recorder The recorder.
+ * @return If the recorder is recording, the hardware functions only build a record when it is.
+ */
+bool commandRecorderActive(commandRecorderStruct *recorder) {
+    pthread_mutex_lock(&recorder->lock);
+    const bool active = recorder->file != NULL;
+    pthread_mutex_unlock(&recorder->lock);
+    return active;
+}
+
+/**
+ * Adds a command or message to the recording.
+ *
+ * @param recorder The recorder.
+ * @param opcode The command.
+ * @param numberOfInts How many whole number arguments the command has.
+ * @param ints The whole number arguments.
+ * @param numberOfTexts How many text arguments the command has, including the result of a message.
+ * @param texts The text arguments.
+ */
+void recordCommand(commandRecorderStruct *recorder, const commandOpcode opcode, const int numberOfInts,
+                   const long long ints[], const int numberOfTexts, const char *const texts[]) {
+    pthread_mutex_lock(&recorder->lock); //The hardware functions can be called from any thread.
+    if (recorder->file == NULL) {
+        pthread_mutex_unlock(&recorder->lock); //Closed since the caller checked.
+        return;
+    }
+    const long long nowUs = monotonicUs();
+    putc(opcode, recorder->file);
+    writeVarint(recorder->file, (uint64_t) (nowUs - recorder->previousUs));
+    recorder->previousUs = nowUs;
+    putc(numberOfInts, recorder->file);
+    for (int i = 0; i < numberOfInts; i++) {
+        //Zigzag encoding keeps small negative numbers small.
+        writeVarint(recorder->file, ((uint64_t) ints[i] << 1) ^ (uint64_t) (ints[i] >> 63));
+    }
+    putc(numberOfTexts, recorder->file);
+    for (int i = 0; i < numberOfTexts; i++) {
+        size_t length = strlen(texts[i]);
+        if (length >= COMMAND_TEXT_BUFFER) {
+            length = COMMAND_TEXT_BUFFER - 1; //Longer than the GUI could have been sent anyway.
+        }
+        writeVarint(recorder->file, length);
+        fwrite(texts[i], 1, length, recorder->file);
+    }
+    recorder->records++;
+    pthread_mutex_unlock(&recorder->lock);
+}
+
+/**
+ * Stops recording, the rest of the recording is written to the file.
+ *
+ * @param recorder The recorder.
+ */
+void closeCommandRecorder(commandRecorderStruct *recorder) {
+    pthread_mutex_lock(&recorder->lock); //A record may be being written on another thread.
+    if (recorder->file == NULL) {
+        pthread_mutex_unlock(&recorder->lock);
+        return;
+    }
+    fclose(recorder->file);
+    recorder->file = NULL;
+    const long long records = recorder->records;
+    pthread_mutex_unlock(&recorder->lock);
+    printf("Command recorder: %lld records\n", records);
+}
+
+/**
+ * Sends one record to the hardware. Messages are sent again but their results aren't used.
+ *
+ * @param opcode The command.
+ * @param ints The whole number arguments.
+ * @param texts The text arguments.
+ */
+static void sendRecord(const int opcode, const long long ints[], char texts[][COMMAND_TEXT_BUFFER]) {
+    switch (opcode) {
+        case COMMAND_CLEAR_DISPLAY:
+            displayClear();
+            break;
+        case COMMAND_MOTOR_STEP:
+            motorStep();
+            break;
+        case COMMAND_CLEAR_AREA:
+            displayClearArea((int) ints[0], (int) ints[1], (int) ints[2], (int) ints[3]);
+            break;
+        case COMMAND_LINE:
+            displayLine((int) ints[0], (int) ints[1], (int) ints[2], (int) ints[3]);
+            break;
+        case COMMAND_SET_RTC:
+            clockSet((int) ints[0], (int) ints[1], (int) ints[2], (int) ints[3], (int) ints[4], (int) ints[5]);
+            break;
+        case COMMAND_PIXEL:
+            displayPixel((int) ints[0], (int) ints[1]);
+            break;
+        case COMMAND_FOOD:
+            foodFill((int) ints[0]);
+            break;
+        case COMMAND_TEXTXY:
+            displayText((int) ints[0], (int) ints[1], texts[0], (int) ints[2]);
+            break;
+        case COMMAND_MESSAGE:
+            infoMessage(texts[0]);
+            break;
+        case COMMAND_COLOUR:
+            displayColour(texts[0], texts[1]);
+            break;
+        case COMMAND_BUTTON:
+            free(buttonState());
+            break;
+        case COMMAND_RTC_WARM_START:
+            clockWarmStart(ints[0]);
+            break;
+        case COMMAND_RTC_SECOND:
+            clockSecond();
+            break;
+        case COMMAND_RTC_MINUTE:
+            clockMinute();
+            break;
+        case COMMAND_RTC_HOUR:
+            clockHour();
+            break;
+        case COMMAND_RTC_DAY:
+            clockDay();
+            break;
+        case COMMAND_RTC_MONTH:
+            clockMonth();
+            break;
+        case COMMAND_RTC_YEAR:
+            clockYear();
+            break;
+        case COMMAND_RTC_DAY_OF_WEEK:
+            clockDayOfWeek();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @param opcode The command, less than COMMAND_OPCODES.
+ * @return How many texts a record of the command has, a message has its result as one more.
+ */
+static int recordedTexts(const int opcode) {
+    return hardwareCommands[opcode].numberOfTexts + (hardwareCommands[opcode].kind == HARDWARE_MESSAGE ? 1 : 0);
+}
+
+/**
+ * Reads a recording and sends every record in it to the hardware, then prints how long it took.
+ * This must be called on the processing thread like any other hardware function.
+ *
+ * @param filename The name of the recording.
+ * @param recordedPace True to keep the gaps between records as they were recorded, false to send them back to back.
+ * @return False if the recording can't be read or is damaged, the records before the damage are still sent.
+ */
+bool replayCommandRecording(const char *filename, const bool recordedPace) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        printf("Command replay: %s can't be opened\n", filename);
+        return false;
+    }
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    if (fread(&magic, sizeof(magic), 1, file) != 1 || fread(&version, sizeof(version), 1, file) != 1 ||
+        magic != COMMAND_RECORDING_MAGIC || version != COMMAND_RECORDING_VERSION) {
+        printf("Command replay: %s isn't a version %d recording\n", filename, COMMAND_RECORDING_VERSION);
+        fclose(file);
+        return false;
+    }
+    long long counts[COMMAND_OPCODES] = {0};
+    long long records = 0;
+    long long recordedUs = 0;
+    bool damaged = false;
+    const long long startUs = monotonicUs();
+    int opcode;
+    while ((opcode = getc(file)) != EOF) {
+        long long ints[COMMAND_MAX_INTS];
+        char texts[COMMAND_MAX_TEXTS][COMMAND_TEXT_BUFFER];
+        uint64_t value;
+        int numberOfInts;
+        int numberOfTexts;
+        damaged = opcode >= COMMAND_OPCODES || !readVarint(file, &value);
+        recordedUs += (long long) value;
+        numberOfInts = damaged ? EOF : getc(file);
+        //A record must have the arguments the table gives its command, or its arguments would be read unset.
+        damaged = damaged || numberOfInts != hardwareCommands[opcode].numberOfInts;
+        for (int i = 0; !damaged && i < numberOfInts; i++) {
+            damaged = !readVarint(file, &value);
+            ints[i] = (long long) (value >> 1) ^ -(long long) (value & 1);
+        }
+        numberOfTexts = damaged ? EOF : getc(file);
+        damaged = damaged || numberOfTexts != recordedTexts(opcode);
+        for (int i = 0; !damaged && i < numberOfTexts; i++) {
+            damaged = !readVarint(file, &value) || value >= COMMAND_TEXT_BUFFER ||
+                      fread(texts[i], 1, (size_t) value, file) != value;
+            if (!damaged) {
+                texts[i][value] = '\0';
+            }
+        }
+        if (damaged) {
+            break;
+        }
+        if (recordedPace) {
+            sleepUntilUs(startUs + recordedUs);
+        }
+        sendRecord(opcode, ints, texts);
+        counts[opcode]++;
+        records++;
+    }
+    fclose(file);
+    const long long elapsedUs = monotonicUs() - startUs;
+    printf("Command replay: %lld records in %.1fms (recorded %.1fms), %.0f records per second%s\n", records,
+           elapsedUs / 1000.0, recordedUs / 1000.0, elapsedUs > 0 ? records * 1e6 / elapsedUs : 0.0,
+           damaged ? ", the recording is damaged after this" : "");
+    for (int i = 0; i < COMMAND_OPCODES; i++) {
+        if (counts[i] > 0) {
+            printf("Command replay: %s sent %lld times\n", commandOpcodeName((commandOpcode) i), counts[i]);
+        }
+    }
+    return !damaged;
+}
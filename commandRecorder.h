@@ -0,0 +1,48 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the command recorder, which records every hardware command the program sends and every message
+* result it gets back, and the replayer that sends a recording to the hardware again.
+*
+* A recording is a compact binary file. It starts with a header (a magic number and the format version) followed by one
+* record per command or message:
+*   the opcode (one byte), the microseconds since the previous record (varint),
+*   the number of whole number arguments (one byte) then each as a zigzag varint,
+*   the number of text arguments (one byte) then each as its length (varint) and its bytes.
+* A message records its result as its last text argument.
+*
+* A replay can run at the recorded pace, so the hardware sees the same timing as the original run, or as fast as
+* possible to measure how quickly the commands can be sent.
+*/
+#ifndef COMMAND_RECORDER_HEADER
+#define COMMAND_RECORDER_HEADER
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "hardwareCommands.h"
+
+#define COMMAND_RECORDING_MAGIC 0x444D4346u //"FCMD" when read as bytes.
+#define COMMAND_RECORDING_VERSION 1
+#define COMMAND_MAX_INTS 8
+#define COMMAND_MAX_TEXTS 3
+#define COMMAND_TEXT_BUFFER 200
+
+/**
+ * An open recording.
+ */
+typedef struct {
+    pthread_mutex_t lock; //Held while a record is written and whenever the file is checked or changed.
+    FILE *file; //NULL when nothing is being recorded.
+    long long previousUs; //When the previous record was made.
+    long long records;
+} commandRecorderStruct;
+
+extern commandRecorderStruct programRecorder; //Records the hardware commands of the program, if asked to.
+
+bool openCommandRecorder(commandRecorderStruct *recorder, const char *filename);
+bool commandRecorderActive(commandRecorderStruct *recorder);
+void recordCommand(commandRecorderStruct *recorder, const commandOpcode opcode, const int numberOfInts,
+                   const long long ints[], const int numberOfTexts, const char *const texts[]);
+void closeCommandRecorder(commandRecorderStruct *recorder);
+bool replayCommandRecording(const char *filename, const bool recordedPace); //Sends a recording to the hardware.
+#endif //COMMAND_RECORDER_HEADER
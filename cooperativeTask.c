@@ -0,0 +1,86 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* Cooperative tasks resumed by the program timer wheel.
+*/
+#include <stddef.h>
+#include "cooperativeTask.h"
+
+/**
+ * Called by the timer wheel when a task has finished waiting, the task carries on from where it stopped.
+ *
+ * @param timer The tasks timer.
+ * @param context The task.
+ */
+static void resumeTask(timerStruct *timer, void *context) {
+    (void) timer;
+    taskStruct *task = context;
+    if (task->running) {
+        task->function(task);
+    }
+}
+
+/**
+ * Starts a task, it runs straight away until it first waits then this returns.
+ *
+ * @param task The task, it must not be running.
+ * @param function The body of the task.
+ * @param context Whatever the task works on, can be NULL.
+ */
+void taskStart(taskStruct *task, taskFunction function, void *context) {
+    task->function = function;
+    task->context = context;
+    task->resumeLine = 0;
+    task->counter = 0;
+    task->running = true;
+    initialiseTimer(&task->timer, resumeTask, task);
+    function(task);
+}
+
+/**
+ * Arms the timer that resumes a task, used by the wait macros.
+ *
+ * @param task The task that is waiting.
+ * @param delayMs How long until the task is resumed.
+ */
+void taskResumeAfter(taskStruct *task, const long delayMs) {
+    timerWheelAdd(&programTimers, &task->timer, delayMs);
+}
+
+/**
+ * Marks a task as done, used by TASK_END.
+ *
+ * @param task The task that has reached its end.
+ */
+void taskFinished(taskStruct *task) {
+    task->running = false;
+}
+
+/**
+ * Stops a task where it is, it is never resumed.
+ *
+ * @param task The task.
+ */
+void taskCancel(taskStruct *task) {
+    timerWheelCancel(&programTimers, &task->timer);
+    task->running = false;
+}
+
+/**
+ * @param task The task.
+ * @return If the task has started and not yet finished.
+ */
+bool taskIsRunning(const taskStruct *task) {
+    return task->running;
+}
+
+/**
+ * Keeps running the event loop until a task finishes, any other task or timer that is due runs meanwhile.
+ *
+ * @param task The task.
+ */
+void taskWaitUntilDone(taskStruct *task) {
+    while (task->running) {
+        timerWheelRunFor(&programTimers, TASK_POLL_MS);
+    }
+}
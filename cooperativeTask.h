@@ -0,0 +1,75 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides cooperative tasks, stackless coroutines that run on the processing thread.
+*
+* A task is a function that can stop part way through at a wait and carry on from the same place when the wait is
+* over, so a long activity like the splash screen doesn't block everything else on the thread while it waits. The task
+* remembers the line it stopped at and a switch jumps back to it when it is resumed, tasks are resumed by their own
+* timer on the program timer wheel.
+*
+* Since a task returns at every wait its local variables are lost, anything that must last across a wait is kept in the
+* task struct or its context. Waits can't be used inside a switch statement of the task.
+*/
+#ifndef COOPERATIVE_TASK_HEADER
+#define COOPERATIVE_TASK_HEADER
+#include <stdbool.h>
+#include "timerWheel.h"
+
+#define TASK_POLL_MS 10L //How often a task waiting for a condition checks it.
+
+typedef struct taskStruct taskStruct;
+typedef void (*taskFunction)(taskStruct *task); //The body of a task.
+
+/**
+ * A task, the struct is owned by whoever starts the task.
+ */
+struct taskStruct {
+    taskFunction function;
+    void *context; //Whatever the task works on.
+    int resumeLine; //The line the task carries on from, 0 is the start.
+    int counter; //Kept across waits, for loops that wait.
+    bool running;
+    timerStruct timer; //Resumes the task when a wait is over.
+};
+
+//Starts the body of a task, jumping to where it last waited.
+#define TASK_BEGIN(task) switch ((task)->resumeLine) { case 0:
+
+//Ends the body of a task.
+#define TASK_END(task) } taskFinished(task)
+
+//Lets everything else that is due run before the task carries on.
+#define TASK_YIELD(task) TASK_SLEEP(task, 0L)
+
+//Waits for a number of milliseconds.
+#define TASK_SLEEP(task, delayMs) \
+    do { \
+        (task)->resumeLine = __LINE__; \
+        taskResumeAfter((task), (delayMs)); \
+        return; \
+        case __LINE__:; \
+    } while (0)
+
+//Waits until the condition is true, the condition is checked every TASK_POLL_MS.
+#define TASK_WAIT_UNTIL(task, condition) \
+    do { \
+        if (!(condition)) { \
+            (task)->resumeLine = __LINE__; \
+            taskResumeAfter((task), TASK_POLL_MS); \
+            return; \
+            case __LINE__: \
+            if (!(condition)) { \
+                taskResumeAfter((task), TASK_POLL_MS); \
+                return; \
+            } \
+        } \
+    } while (0)
+
+void taskStart(taskStruct *task, taskFunction function, void *context); //Runs the task until its first wait.
+void taskResumeAfter(taskStruct *task, const long delayMs); //Arms the timer that resumes the task.
+void taskFinished(taskStruct *task); //Marks the task as done, called by TASK_END.
+void taskCancel(taskStruct *task); //Stops the task where it is.
+bool taskIsRunning(const taskStruct *task);
+void taskWaitUntilDone(taskStruct *task); //Runs the event loop until the task finishes.
+#endif //COOPERATIVE_TASK_HEADER
@@ -3,14 +3,18 @@
 *
 * Display functions that are used by the menus and screens.
 */
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "menusFunctions.h"
+#include "cooperativeTask.h"
 #include "splashScreenImagePt1.h"
 #include "displayScreens.h"
 #include "fish.h"
+#include "graphicsState.h"
+#include "screenTemplate.h"
 #include "splashScreenImagePt2.h"
 #include "splashScreenImagePt3.h"
 #include "splashScreenImagePt4.h"
@@ -19,47 +23,174 @@
 #define CHAR_WIDTH 6
 #define CHAR_HEIGHT 8
 #define LINE_BUFFER 22
+#define SCREEN_TEMPLATES 16
+//The titles of the screens, each screen's template is found by its title.
+#define MAIN_SCREEN_TITLE "Fish Feeder"
+#define EDIT_SCHEDULE_TITLE "Choose time to edit:"
+#define CONFIGURATION_TITLE "Config menu:"
+#define SET_THE_CLOCK_TITLE "Set the clock:"
+#define OPERATING_MODE_TITLE "Operating Mode:"
+#define CONFIG_FEED_SCHEDULE_TITLE "Config Feed Schedule:"
+#define SET_THE_TIME_TITLE "Set the time:"
+#define SET_THE_DATE_TITLE "Set the date:"
+#define SCHEDULE_TIME_TITLE "Time to feed:"
+#define ROTATIONS_TITLE "Number of rotations:"
+#define FEEDS_AMOUNT_TITLE "Daily feeds:"
+
+static bool screenBlanked = false; //If the blank screen is showing, nothing else should be drawn.
+static graphicsStateStruct *const graphics = &programGraphics; //Everything is drawn through the graphics state.
+
 //DISPLAY SPLASH SCREEN
 /**
- * Displays an image made of pixels by taking a 3D array of 8 Bit values and converting them into hex.
- * This makes them compatible with the displayColour function.
- * Displays the pixel using displayLine because the displayPixel function because the colour can be chosen.
+ * A run of pixels on one row of the splash screen that are all the same colour, drawn as a single line.
+ */
+typedef struct {
+    uint8_t y;
+    uint8_t startX;
+    uint8_t endX;
+    uint8_t colour; //The palette index of the colour.
+} splashRunStruct;
+
+/**
+ * A frame of the splash screen decoded into the runs that draw it.
+ */
+typedef struct {
+    int numberOfRuns;
+    splashRunStruct runs[SCREEN_WIDTH * SCREEN_HEIGHT]; //Enough for a frame where no two pixels next to each other match.
+} splashFrameStruct;
+
+/**
+ * The frames of the splash screen in the order they are shown.
+ */
+static const uint8_t (*const splashFrames[SPLASH_FRAMES])[128][3] = {
+    splashScreenPt1, splashScreenPt2, splashScreenPt3, splashScreenPt4
+};
+
+static splashFrameStruct decodedSplashFrames[SPLASH_FRAMES];
+static pthread_once_t splashDecoded = PTHREAD_ONCE_INIT;
+
+/**
+ * Orders runs by their colour, then top to bottom and left to right.
  *
- * @param image An array of values making up an image in 8-bit RGB..
+ * @param first The first run.
+ * @param second The second run.
+ * @return Less than 0 if the first run goes first, more than 0 if the second does.
  */
-void displayPtOfSplashScreen(const uint8_t image[64][128][3]) {
+static int compareSplashRuns(const void *first, const void *second) {
+    const splashRunStruct *firstRun = first;
+    const splashRunStruct *secondRun = second;
+    if (firstRun->colour != secondRun->colour) {
+        return firstRun->colour - secondRun->colour;
+    }
+    if (firstRun->y != secondRun->y) {
+        return firstRun->y - secondRun->y;
+    }
+    return firstRun->startX - secondRun->startX;
+}
+
+/**
+ * Decodes an image made of pixels from a 3D array of 8 Bit values into runs of pixels with the same colour, each colour
+ * is added to the palette. The runs are sorted by colour so the colour only has to be changed once per colour when the
+ * frame is drawn, runs never overlap so the order they are drawn in doesn't change the picture.
+ *
+ * @param image An array of values making up an image in 8-bit RGB.
+ * @param frame The frame the runs are written to.
+ */
+static void decodeSplashFrame(const uint8_t image[64][128][3], splashFrameStruct *frame) {
+    frame->numberOfRuns = 0;
     for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        for (int x = 0; x < SCREEN_WIDTH; x++) {
+        int x = 0;
+        while (x < SCREEN_WIDTH) {
+            //The run carries on while the next pixel is the same colour.
+            int endX = x;
+            while (endX + 1 < SCREEN_WIDTH && memcmp(image[y][endX + 1], image[y][x], 3) == 0) {
+                endX++;
+            }
+            splashRunStruct *run = &frame->runs[frame->numberOfRuns++];
+            run->y = (uint8_t) y;
+            run->startX = (uint8_t) x;
+            run->endX = (uint8_t) endX;
+            run->colour = (uint8_t) paletteColour(graphics, image[y][x][0], image[y][x][1], image[y][x][2]);
+            x = endX + 1;
+        }
+    }
+    qsort(frame->runs, (size_t) frame->numberOfRuns, sizeof(splashRunStruct), compareSplashRuns);
+}
 
-            uint8_t red = image[y][x][0];   // Gets the red part
-            uint8_t green = image[y][x][1]; // Gets the green part
-            uint8_t blue = image[y][x][2];  // Gets the blue part
+/**
+ * Draws a decoded frame, each run is displayed as a span because the colour can be chosen.
+ *
+ * @param frame The frame to be drawn.
+ */
+static void drawSplashFrame(const splashFrameStruct *frame) {
+    for (int i = 0; i < frame->numberOfRuns; i++) {
+        const splashRunStruct *run = &frame->runs[i];
+        graphicsColour(graphics, run->colour, PALETTE_FEEDER_BLUE); //Default but functionally useless background.
+        graphicsSpan(graphics, run->startX, run->endX, run->y); // Displays the run with the given colour.
+    }
+}
 
-            // Format into a hex string
-            char colourInHex[8]; // Char will hold color in a #RRGGBB format
-            snprintf(colourInHex, 8, "#%02X%02X%02X", red, green, blue);
+/**
+ * Decodes every frame of the splash screen, run once by whichever thread needs the frames first.
+ */
+static void decodeAllSplashFrames() {
+    for (int i = 0; i < SPLASH_FRAMES; i++) {
+        decodeSplashFrame(splashFrames[i], &decodedSplashFrames[i]);
+    }
+}
 
-            // Display the pixel at (x, y) with the selected colour.
-            displayColour(colourInHex, "50cae0"); // Default but functionally useless background colour.
-            displayLine(x, y, x, y); // Displays pixel with the given colour.
-        }
+/**
+ * Decodes the splash screen so it is ready before it is shown. This is safe to call from any thread, if another thread
+ * is already decoding it this waits for that thread to finish.
+ */
+void decodeSplashScreen() {
+    pthread_once(&splashDecoded, decodeAllSplashFrames);
+}
+
+/**
+ * Displays one of the decoded frames of the splash screen, decoding them first if they haven't been.
+ *
+ * @param frameIndex Which frame to display, from 0 to SPLASH_FRAMES - 1.
+ */
+void displaySplashFrame(const int frameIndex) {
+    decodeSplashScreen();
+    drawSplashFrame(&decodedSplashFrames[frameIndex]);
+}
+
+/**
+ * Displays the parts of the splash screen one after another with 2500 milliseconds between each frame, to create a
+ * moving image affect. This splash screen resembles two fish in a circular swimming pattern. This resembles a loading
+ * circle, so the frames keep going round until the program has started and the task is stopped.
+ * The task waits between frames so the processing thread is free to do other work while the splash screen shows.
+ *
+ * @param task The splash screen task, its counter is the frame being shown.
+ */
+static void splashScreenTask(taskStruct *task) {
+    TASK_BEGIN(task);
+    for (task->counter = 0;; task->counter = (task->counter + 1) % SPLASH_FRAMES) {
+        displaySplashFrame(task->counter);
+        TASK_SLEEP(task, SPLASH_FRAME_MS);
     }
+    TASK_END(task);
 }
 
 /**
- * Displays all the parts of the splash screen one after with 2500 milliseconds between each frame, to create a moving image affect.
- * This splash screen resembles two fish in a circular swimming pattern. This resembles a loading circle.
+ * Starts showing the splash screen, this returns once the first frame is drawn and the rest are drawn by the event loop
+ * until the splash screen is stopped.
+ *
+ * @param task The task that shows the splash screen.
  */
-void displaySplashScreen() {
-    displayPtOfSplashScreen(splashScreenPt1);
-    msleep(2500L);
-    displayPtOfSplashScreen(splashScreenPt2);
-    msleep(2500L);
-    displayPtOfSplashScreen(splashScreenPt3);
-    msleep(2500L);
-    displayPtOfSplashScreen(splashScreenPt4);
-    msleep(2500L);
+void startSplashScreen(taskStruct *task) {
+    taskStart(task, splashScreenTask, NULL);
+}
 
+/**
+ * Stops the splash screen, the frame showing stays on the display until something else is drawn.
+ *
+ * @param task The task that shows the splash screen.
+ */
+void stopSplashScreen(taskStruct *task) {
+    taskCancel(task);
 }
 
 //BASIC DISPLAY
@@ -69,8 +200,132 @@ void displaySplashScreen() {
  * default colours for this program.
  */
 void basicDisplay() {
-    displayColour("white", "50cae0");
-    displayClear();
+    graphicsColour(graphics, PALETTE_WHITE, PALETTE_FEEDER_BLUE);
+    graphicsClear(graphics);
+}
+
+//SCREEN TEMPLATES
+typedef void (*templateBuilder)(screenTemplateStruct *screenTemplate); //Adds a screen's items to its template.
+
+static screenTemplateStruct screenTemplates[SCREEN_TEMPLATES];
+static int numberOfScreenTemplates = 0;
+static pthread_once_t screenTemplatesBuilt = PTHREAD_ONCE_INIT;
+
+/**
+ * Builds the template of the main screen, its title and the lines around the title and the time.
+ *
+ * @param screenTemplate The template, named MAIN_SCREEN_TITLE.
+ */
+static void buildMainScreenTemplate(screenTemplateStruct *screenTemplate) {
+    int xCoOrdinates = (SCREEN_WIDTH - (11 * CHAR_WIDTH)) / 2; // Center x-coordinate for the title.
+    templateText(screenTemplate, xCoOrdinates, 5, screenTemplate->name, 1); //Display the title.
+    templateLine(screenTemplate, 0, CHAR_HEIGHT * 2 + 1, SCREEN_WIDTH, CHAR_HEIGHT * 2 + 1); //Line under title.
+    // display graphic lines which will be around the time/date
+    templateLine(screenTemplate, 0, SCREEN_HEIGHT - 1, SCREEN_WIDTH, SCREEN_HEIGHT - 1);
+    templateLine(screenTemplate, 0, SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 1, SCREEN_WIDTH,
+                 SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 1);
+}
+
+/**
+ * Builds the template of a screen of options, its title and the line under it.
+ *
+ * @param screenTemplate The template, named after the title.
+ */
+static void buildOptionsTemplate(screenTemplateStruct *screenTemplate) {
+    templateText(screenTemplate, 0, 1, screenTemplate->name, 1); //Displays top text.
+    templateLine(screenTemplate, 0, CHAR_HEIGHT + 2, SCREEN_WIDTH, CHAR_HEIGHT + 2); //Line at the top of screen.
+}
+
+/**
+ * Builds the template of a screen of digits, its title, the lines at the top and bottom and the arrows above and below
+ * each digit. After two digits the next character doesn't have arrows to allow space for a ':' or a '/'.
+ *
+ * @param screenTemplate The template, named after the title with the number of characters as its variant.
+ */
+static void buildDigitsTemplate(screenTemplateStruct *screenTemplate) {
+    const int charAmount = screenTemplate->variant;
+    templateText(screenTemplate, 0, 1, screenTemplate->name, 1); //Displays Top text.
+    //Displays lines at top and bottom of the screen.
+    templateLine(screenTemplate, 0, CHAR_HEIGHT + 1, SCREEN_WIDTH, CHAR_HEIGHT + 1);
+    templateLine(screenTemplate, 0, (SCREEN_HEIGHT - CHAR_HEIGHT) - 3, SCREEN_WIDTH, SCREEN_HEIGHT - CHAR_HEIGHT - 3);
+    int middleXCoordinate = (SCREEN_WIDTH - CHAR_WIDTH * 2 * charAmount) / 2; //adjusts accordingly.
+    int middleYCoordinate = (SCREEN_HEIGHT - CHAR_HEIGHT * 2) / 2;
+    for (int i = 0; i < charAmount; i++) {
+        if (!(i == 2 || i == 5)) {
+            templateText(screenTemplate, middleXCoordinate, (middleYCoordinate - 3) - CHAR_HEIGHT, "/\\", 1);
+            templateText(screenTemplate, middleXCoordinate, middleYCoordinate + CHAR_HEIGHT * 2 + 3, "\\/", 1);
+        }
+        middleXCoordinate += CHAR_WIDTH * 2;
+    }
+}
+
+/**
+ * Adds a template to the cache.
+ *
+ * @param name The screen's title.
+ * @param variant Tells apart templates for the same screen.
+ * @param build Adds the screen's items to the template.
+ * @return The template.
+ */
+static screenTemplateStruct *addScreenTemplate(const char *name, const int variant, const templateBuilder build) {
+    screenTemplateStruct *screenTemplate;
+    if (numberOfScreenTemplates == SCREEN_TEMPLATES) {
+        //The cache is full, so the last template is built again for this screen.
+        screenTemplate = &screenTemplates[SCREEN_TEMPLATES - 1];
+        if (graphics->shownTemplate == screenTemplate) {
+            graphics->shownTemplate = NULL;
+        }
+    } else {
+        screenTemplate = &screenTemplates[numberOfScreenTemplates++];
+    }
+    initialiseScreenTemplate(screenTemplate, name, variant);
+    build(screenTemplate);
+    return screenTemplate;
+}
+
+/**
+ * Builds the template of every screen, run once by whichever thread needs them first.
+ */
+static void buildAllScreenTemplates() {
+    addScreenTemplate(MAIN_SCREEN_TITLE, 0, buildMainScreenTemplate);
+    const char *optionsTitles[] = {
+        EDIT_SCHEDULE_TITLE, CONFIGURATION_TITLE, SET_THE_CLOCK_TITLE, OPERATING_MODE_TITLE, CONFIG_FEED_SCHEDULE_TITLE
+    };
+    for (int i = 0; i < 5; i++) {
+        addScreenTemplate(optionsTitles[i], 0, buildOptionsTemplate);
+    }
+    addScreenTemplate(SET_THE_TIME_TITLE, 8, buildDigitsTemplate);
+    addScreenTemplate(SET_THE_DATE_TITLE, 10, buildDigitsTemplate);
+    addScreenTemplate(SCHEDULE_TIME_TITLE, 5, buildDigitsTemplate);
+    addScreenTemplate(ROTATIONS_TITLE, 1, buildDigitsTemplate);
+    addScreenTemplate(FEEDS_AMOUNT_TITLE, 1, buildDigitsTemplate);
+}
+
+/**
+ * Builds the template of every screen so they are ready before they are shown. This is safe to call from any thread,
+ * if another thread is already building them this waits for that thread to finish.
+ */
+void buildScreenTemplates() {
+    pthread_once(&screenTemplatesBuilt, buildAllScreenTemplates);
+}
+
+/**
+ * Finds the template of a screen, building it if it wasn't built with the others.
+ *
+ * @param name The screen's title.
+ * @param variant Tells apart templates for the same screen.
+ * @param build Adds the screen's items to the template, used if it hasn't been built.
+ * @return The template.
+ */
+static const screenTemplateStruct *findScreenTemplate(const char *name, const int variant,
+                                                      const templateBuilder build) {
+    buildScreenTemplates();
+    for (int i = 0; i < numberOfScreenTemplates; i++) {
+        if (screenTemplates[i].variant == variant && strcmp(screenTemplates[i].name, name) == 0) {
+            return &screenTemplates[i];
+        }
+    }
+    return addScreenTemplate(name, variant, build);
 }
 
 //MAIN SCREEN
@@ -89,26 +344,26 @@ void updateTimeDisplay(int *previousSecond) {
         snprintf(time, 22, "%02i/%02i/%04i  %02i:%02i:%02i", clockDay(), clockMonth(), clockYear(), clockHour(),
                  clockMinute(), clockSecond());
         int xCoOrdinates = (SCREEN_WIDTH - CHAR_WIDTH * 20) / 2; // Center x-coordinate
-        displayText(xCoOrdinates, SCREEN_HEIGHT - CHAR_HEIGHT * 1.5, time, 1);
+        graphicsText(graphics, xCoOrdinates, SCREEN_HEIGHT - CHAR_HEIGHT * 1.5, time, 1);
     }
 }
 
 /**
  * Display function for the main screen. The programs name will be displayed and information about the operating mode will be displayed.
  * The information that will be displayed: what the current mode is, when the next feed will be, and how many auto feeds have been done.
- * This works in conjunction with updateTimeDisplay to make the main screen display.
+ * This works in conjunction with updateTimeDisplay to make the main screen display. The title and lines come from the
+ * screen's template.
  *
  * @param operatingMode The operating mode where the information displayed will come from.
  */
 void displayMainScreen(operatingModeStruct *operatingMode) {
-    basicDisplay();
+    if (graphicsShowTemplate(graphics, findScreenTemplate(MAIN_SCREEN_TITLE, 0, buildMainScreenTemplate))) {
+        //The title and lines are already showing, only the information between them changes.
+        graphicsClearArea(graphics, 0, CHAR_HEIGHT * 2 + 2, SCREEN_WIDTH, SCREEN_HEIGHT - CHAR_HEIGHT * 4 - 4);
+    }
     char operatingModeType[LINE_BUFFER]; //Will hold the current mode information in a char format.
     char nextFeedTime[LINE_BUFFER]; //Will hold the next feed time in a char format.
     char autoFeedsDoneNumber[LINE_BUFFER]; //Will hold how many feeds have been done automatically in a char format
-    char *title = "Fish Feeder";
-    int xCoOrdinates = (SCREEN_WIDTH - (11 * CHAR_WIDTH)) / 2; // Center x-coordinate for the title.
-    displayText(xCoOrdinates, 5, title, 1); //Display the title.
-    displayLine(0,CHAR_HEIGHT * 2 + 1,SCREEN_WIDTH,CHAR_HEIGHT * 2 + 1); //Displays a line under title.
     int nextFeedTimeIndex = operatingMode->nextFeed; //A local int holding index of the next feed time.
     if (operatingMode->mode == 0) {
         //If the operating mode is on automatic mode.
@@ -123,19 +378,16 @@ void displayMainScreen(operatingModeStruct *operatingMode) {
     //Can only show 3 characters for the auto feeds so a measure is taken when increasing number of automatic feeds so it resets the counter at 999.
     snprintf(autoFeedsDoneNumber, LINE_BUFFER, "Auto feeds done: %d", operatingMode->autoFeedsDone);
     //Displays all the information.
-    displayText(1,CHAR_HEIGHT * 2.5 + 1, operatingModeType, 1);
-    displayText(1,CHAR_HEIGHT * 3.5 + 1, autoFeedsDoneNumber, 1);
-    displayText(1,CHAR_HEIGHT * 4.5 + 1, nextFeedTime, 1);
-
-    // display graphic lines which will be around the time/date
-    displayLine(0, SCREEN_HEIGHT - 1, SCREEN_WIDTH, SCREEN_HEIGHT - 1);
-    displayLine(0, SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 1, SCREEN_WIDTH, SCREEN_HEIGHT - CHAR_HEIGHT * 2 - 1);
+    graphicsText(graphics, 1,CHAR_HEIGHT * 2.5 + 1, operatingModeType, 1);
+    graphicsText(graphics, 1,CHAR_HEIGHT * 3.5 + 1, autoFeedsDoneNumber, 1);
+    graphicsText(graphics, 1,CHAR_HEIGHT * 4.5 + 1, nextFeedTime, 1);
 }
 
 //FUNCTIONS THAT DISPLAY MULTIPLE OPTIONS THAT CAN BE SCROLLED THROUGH
 /**
  * A generic function that displays a menus options. If the menu has more than 4 options then it allows the user to
  * "Scroll" through the options. As well as this it displays a line and text at the top of the display. The current selection is always highlighted.
+ * The text and line at the top come from the screen's template.
  *
  * @param optionsAmount How many options the menu has.
  * @param options The options the menu has.
@@ -145,9 +397,10 @@ void displayMainScreen(operatingModeStruct *operatingMode) {
 void displayOptions(const int optionsAmount, char options[optionsAmount][LINE_BUFFER], const int currentSelection,
                     char *topText) {
     int startIndex;
-    basicDisplay();
-    displayText(0, 1, topText, 1); //Displays top text.
-    displayLine(0,CHAR_HEIGHT + 2, SCREEN_WIDTH,CHAR_HEIGHT + 2); //Displays line at the top of screen.
+    if (graphicsShowTemplate(graphics, findScreenTemplate(topText, 0, buildOptionsTemplate))) {
+        //The top text and line are already showing, only the options change.
+        graphicsClearArea(graphics, 0, CHAR_HEIGHT * 2, SCREEN_WIDTH, SCREEN_HEIGHT - CHAR_HEIGHT * 2);
+    }
     if (currentSelection >= 4) {
         //If the currently selected option is the 5th option or more.
         startIndex = currentSelection - 3;
@@ -159,8 +412,9 @@ void displayOptions(const int optionsAmount, char options[optionsAmount][LINE_BU
     double multiplicationFactor = 2; //The multiplication factor that affects where the first option is shown.
     for (int i = startIndex; (optionsAmount >= 4 ? i < (startIndex + 4) : i < optionsAmount); i++) {
         //Displays 4 options from the start index or if there aren't 4 options, displays all the options from the start index.
-        (currentSelection == i) ? displayColour("50cae0", "white") : displayColour("white", "50cae0");
-        displayText(0,CHAR_HEIGHT * multiplicationFactor, options[i], 1);
+        (currentSelection == i) ? graphicsColour(graphics, PALETTE_FEEDER_BLUE, PALETTE_WHITE)
+                                : graphicsColour(graphics, PALETTE_WHITE, PALETTE_FEEDER_BLUE);
+        graphicsText(graphics, 0,CHAR_HEIGHT * multiplicationFactor, options[i], 1);
         multiplicationFactor += 1.5; //Leaves a bit of space between options
     }
 }
@@ -179,7 +433,7 @@ void displayEditCurrentSchedule(const int currentSelection, operatingModeStruct
                  operatingMode->feedTimes[i].minute);
     }
     strcpy(selectionOptions[operatingMode->numberOfFeedsInADay], "Exit");
-    displayOptions(operatingMode->numberOfFeedsInADay + 1, selectionOptions, currentSelection, "Choose time to edit:");
+    displayOptions(operatingMode->numberOfFeedsInADay + 1, selectionOptions, currentSelection, EDIT_SCHEDULE_TITLE);
 }
 
 /**
@@ -190,7 +444,7 @@ void displayEditCurrentSchedule(const int currentSelection, operatingModeStruct
  */
 void displayConfigurationMenu(const int currentSelection) {
     char selectionOptions[4][LINE_BUFFER] = {"Set The Clock", "Config Feed Schedule", "Select Operating Mode", "Exit"};
-    displayOptions(4, selectionOptions, currentSelection, "Config menu:");
+    displayOptions(4, selectionOptions, currentSelection, CONFIGURATION_TITLE);
 }
 
 /**
@@ -201,7 +455,7 @@ void displayConfigurationMenu(const int currentSelection) {
  */
 void displaySetTheClockMenu(const int currentSelection) {
     char selectionOptions[3][LINE_BUFFER] = {"Set the date", "Set the time", "Exit"};
-    displayOptions(3, selectionOptions, currentSelection, "Set the clock:");
+    displayOptions(3, selectionOptions, currentSelection, SET_THE_CLOCK_TITLE);
 }
 
 /**
@@ -212,7 +466,7 @@ void displaySetTheClockMenu(const int currentSelection) {
  */
 void displayOperatingModeMenu(const int currentSelection) {
     char selectionOptions[5][LINE_BUFFER] = {"Paused", "Auto", "Feed Now", "Skip Next feed", "Exit"};
-    displayOptions(5, selectionOptions, currentSelection, "Operating Mode:");
+    displayOptions(5, selectionOptions, currentSelection, OPERATING_MODE_TITLE);
 }
 
 /**
@@ -223,13 +477,13 @@ void displayOperatingModeMenu(const int currentSelection) {
  */
 void displayConfigFeedScheduleMenu(const int currentSelection) {
     char selectionOptions[3][LINE_BUFFER] = {"New Schedule", "Edit Schedule", "Exit"};
-    displayOptions(3, selectionOptions, currentSelection, "Config Feed Schedule:");
+    displayOptions(3, selectionOptions, currentSelection, CONFIG_FEED_SCHEDULE_TITLE);
 }
 
 // FUNCTIONS THAT DISPLAY NUMBERS THAT CAN BE CHANGED
 
 /**
- * Displays a boarder by drawing four lines between the four parameters.
+ * Displays a boarder as the outline of a rectangle with its corners at the four parameters.
  *
  * @param x The left most of the boarder .
  * @param y The top most of the boarder.
@@ -237,17 +491,14 @@ void displayConfigFeedScheduleMenu(const int currentSelection) {
  * @param y1 The bottom most of the boarder.
  */
 void displayBoarder(int x, int y, int x1, int y1) {
-    displayLine(x, y, x1, y); //Draws the top of the boarder.
-    displayLine(x, y1, x1, y1); //Draws the bottom of the boarder.
-    displayLine(x, y, x, y1); //Draws the left of the boarder.
-    displayLine(x1, y, x1, y1); //Draws the right of the boarder.
+    graphicsRectangle(graphics, x, y, x1, y1);
 }
 
 /**
  * A generic function that displays the digit/digits given with arrows above and below them,
  * After two digits the next character won't have arrows above it to allow space for a ':' or a '/'.
  * It displays two lines at the top and the bottom, as well as text at the top and bottom of the display.
- * The current selection is always highlighted.
+ * The current selection is always highlighted. The top text, lines and arrows come from the screen's template.
  *
  * @param charAmount How many characters should be displayed.
  * @param displayedChars An array holding the characters to be displayed.
@@ -257,27 +508,23 @@ void displayBoarder(int x, int y, int x1, int y1) {
  */
 void setDigitsDisplay(const int charAmount, char displayedChars[charAmount][3], const int currentSelection,
                       char *bottomText, char *topText) {
-    basicDisplay();
-    displayText(0, 1, topText, 1); //Displays Top text.
-    displayText(0, (SCREEN_HEIGHT - CHAR_HEIGHT), bottomText, 1); // Displays Bottom text.
-
-    //Displays lines at top and bottom of the screen.
-    displayLine(0,CHAR_HEIGHT + 1, SCREEN_WIDTH,CHAR_HEIGHT + 1);
-    displayLine(0, (SCREEN_HEIGHT - CHAR_HEIGHT) - 3, SCREEN_WIDTH,SCREEN_HEIGHT - CHAR_HEIGHT - 3);
-
     int middleXCoordinate = (SCREEN_WIDTH - CHAR_WIDTH * 2 * charAmount) / 2; //adjusts accordingly.
     int middleYCoordinate = (SCREEN_HEIGHT - CHAR_HEIGHT * 2) / 2;
     int middleXCoordinateForBoarder = middleXCoordinate;
+    if (graphicsShowTemplate(graphics, findScreenTemplate(topText, charAmount, buildDigitsTemplate))) {
+        //The top text, lines and arrows are already showing, only the digits, their boarder and bottom text change.
+        graphicsClearArea(graphics, middleXCoordinate - 1, middleYCoordinate - 1, CHAR_WIDTH * 2 * charAmount + 1,
+                          CHAR_HEIGHT * 2 + 1);
+        graphicsClearArea(graphics, 0, SCREEN_HEIGHT - CHAR_HEIGHT, SCREEN_WIDTH, CHAR_HEIGHT);
+    }
+    graphicsText(graphics, 0, (SCREEN_HEIGHT - CHAR_HEIGHT), bottomText, 1); // Displays Bottom text.
+
     for (int i = 0; i < charAmount; i++) {
         if (currentSelection == i) {
-            displayColour("50cae0", "white");
-        }
-        displayText(middleXCoordinate, middleYCoordinate, displayedChars[i], 2);
-        displayColour("white", "50cae0");
-        if (!(i == 2 || i == 5)) {
-            displayText(middleXCoordinate, (middleYCoordinate - 3) - CHAR_HEIGHT, "/\\", 1);
-            displayText(middleXCoordinate, middleYCoordinate + CHAR_HEIGHT * 2 + 3, "\\/", 1);
+            graphicsColour(graphics, PALETTE_FEEDER_BLUE, PALETTE_WHITE);
         }
+        graphicsText(graphics, middleXCoordinate, middleYCoordinate, displayedChars[i], 2);
+        graphicsColour(graphics, PALETTE_WHITE, PALETTE_FEEDER_BLUE);
         middleXCoordinate += CHAR_WIDTH * 2;
     }
     displayBoarder(middleXCoordinateForBoarder - 1, middleYCoordinate - 1,
@@ -304,7 +551,7 @@ void displaySetTheTimeScreen(const int currentSelection, int digits[6], char *bo
     snprintf(displayedChars[6], 3, "%d", digits[4]);
     snprintf(displayedChars[7], 3, "%d", digits[5]);
     //Displays the Time appropriately.
-    setDigitsDisplay(8, displayedChars, currentSelection, bottomText, "Set the time:");
+    setDigitsDisplay(8, displayedChars, currentSelection, bottomText, SET_THE_TIME_TITLE);
 }
 
 /**
@@ -328,7 +575,7 @@ void displaySetTheDateScreen(const int currentSelection, int digits[8], char *bo
     snprintf(displayedChars[8], 3, "%d", digits[6]);
     snprintf(displayedChars[9], 3, "%d", digits[7]);
     //Displays the date appropriately.
-    setDigitsDisplay(10, displayedChars, currentSelection, bottomText, "Set the date:");
+    setDigitsDisplay(10, displayedChars, currentSelection, bottomText, SET_THE_DATE_TITLE);
 }
 
 /**
@@ -347,7 +594,7 @@ void displayScheduleGetTime(const int currentSelection, int digits[4], char *bot
     snprintf(displayedChars[3], 3, "%d", digits[2]);
     snprintf(displayedChars[4], 3, "%d", digits[3]);
     //Displays the time appropriately.
-    setDigitsDisplay(5, displayedChars, currentSelection, bottomText, "Time to feed:");
+    setDigitsDisplay(5, displayedChars, currentSelection, bottomText, SCHEDULE_TIME_TITLE);
 }
 
 /**
@@ -360,7 +607,7 @@ void displayScheduleGetRotations(const int currentSelection) {
     char currentCharacter[1][3];
     snprintf(currentCharacter[0], 3, "%d", currentSelection);
     //Displays the number of rotations selection appropriately.
-    setDigitsDisplay(1, currentCharacter, 0, "", "Number of rotations:");
+    setDigitsDisplay(1, currentCharacter, 0, "", ROTATIONS_TITLE);
 }
 
 /**
@@ -373,30 +620,40 @@ void displayScheduleGetFeedsAmount(const int currentSelection) {
     char currentCharacter[1][3];
     snprintf(currentCharacter[0], 3, "%d", currentSelection);
     //Displays the number of daily feeds selection appropriately.
-    setDigitsDisplay(1, currentCharacter, 0, "", "Daily feeds:");
+    setDigitsDisplay(1, currentCharacter, 0, "", FEEDS_AMOUNT_TITLE);
+}
+
+//FEED PROGRESS
+/**
+ * Draws a progress bar along the top row of the display while the motor is feeding, none of the screens use this row.
+ * The bar is removed when the feed is finished. Nothing is drawn while the screen is blank.
+ * The menu engine draws this in a frame, the motor controllers progress callback only asks for the frame.
+ *
+ * @param percentDone How much of the feed has been done.
+ */
+void displayFeedProgress(const int percentDone) {
+    if (screenBlanked) {
+        return;
+    }
+    graphicsColour(graphics, PALETTE_WHITE, PALETTE_FEEDER_BLUE);
+    if (percentDone >= 100) {
+        graphicsClearArea(graphics, 0, 0, SCREEN_WIDTH, 1); //Removes the bar.
+    } else if (percentDone > 0) {
+        graphicsSpan(graphics, 0, SCREEN_WIDTH * percentDone / 100, 0);
+    }
 }
 
 //THE BLANK SCREEN FUNCTION
 
 /**
- * Clears the display while there is inactivity so to stop burn out of the oled screen.
- * @param operatingMode The operating mode holding the current feed schedule which will be used to check if the fish should be fed.
- */
-void blankScreen(operatingModeStruct *operatingMode) {
-    bool runningBlankScreen = true; //Keeps the screen blank until user gives an input.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    displayClear(); //Clears the display
-    /*
-     * Loop that checks for button presses.
-     */
-    while (runningBlankScreen) {
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        char *result = buttonState(); //Get the button state.
-        // Short pressing the button allows the user to return to the previous screen they were on.
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            runningBlankScreen = false; // Exits the loop
-        }
-        msleep(500L); //Ensures 0.5 seconds pass
+ * Clears the display while there is inactivity so to stop burn out of the oled screen, nothing is drawn until the
+ * screen is unblanked.
+ *
+ * @param blanked True to blank the screen, false once the user has returned to the screen.
+ */
+void setScreenBlanked(const bool blanked) {
+    screenBlanked = blanked;
+    if (blanked) {
+        graphicsClear(graphics); //Clears the display
     }
 }
@@ -5,24 +5,36 @@
 *
 * The display splash screen section includes functions that together display the splash screen.
 * The basic display function section includes a function that is the generic display set up.
+* The screen templates section includes a function that builds the parts of each screen that never change.
 * The main screen section includes functions that together display the main screen.
 * The functions that display multiple options section includes functions that use the displayOptions function.
 * The functions that display numbers section includes functions that use the setDigitsDisplay.
-* The blank screen function section includes a function that is the generic blank display set up.
+* The feed progress section includes a function that shows the progress of a feed while the menus are in use.
+* The blank screen function section includes a function that blanks and unblanks the display.
 *
 */
 #ifndef DISPLAY_SCREENS_HEADER
 #define DISPLAY_SCREENS_HEADER
+#include <stdbool.h>
 #include <stdint.h>
+#include "cooperativeTask.h"
 #include "operatingMode.h"
 
+#define SPLASH_FRAMES 4
+#define SPLASH_FRAME_MS 2500L
+
 //DISPLAY SPLASH SCREEN
-void displayPtOfSplashScreen(const uint8_t image[64][128][3]); //A helper function for displaying the splash screen
-void displaySplashScreen(); //Displays the changing splash screen
+void decodeSplashScreen(); //Gets every frame ready to be drawn, can be called from any thread.
+void displaySplashFrame(const int frameIndex); //Displays one frame of the splash screen.
+void startSplashScreen(taskStruct *task); //Starts the changing splash screen as a task.
+void stopSplashScreen(taskStruct *task); //Stops the changing splash screen.
 
 //BASIC DISPLAY FUNCTION
 void basicDisplay(); //Generic set up for a display.
 
+//SCREEN TEMPLATES
+void buildScreenTemplates(); //Builds the parts of the screens that never change, can be called from any thread.
+
 //MAIN SCREEN
 void displayMainScreen(operatingModeStruct *operatingMode); //Displays the main screen
 void updateTimeDisplay(int *previousSecond); //Updates the time display on the main screen
@@ -56,6 +68,9 @@ void displayScheduleGetRotations(const int currentSelection);
 void displayScheduleGetFeedsAmount(const int currentSelection);
 
 
+//FEED PROGRESS
+void displayFeedProgress(const int percentDone); //Shows how far through a feed the motor is.
+
 //THE BLANK SCREEN FUNCTION
-void blankScreen(operatingModeStruct *operatingMode); //Clears the display.
+void setScreenBlanked(const bool blanked); //Clears the display and stops anything else being drawn.
 #endif //DISPLAY_SCREENS_HEADER
@@ -0,0 +1,414 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The EEPROM image, a memory mapped binary file with a checked header, wear-levelled slots and page write counters.
+* Saves go to the bank that isn't in use and are switched to in one write once they are on disk.
+*/
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "eepromImage.h"
+#define CRC32_POLYNOMIAL 0xEDB88320u
+#define FILENAME_BUFFER 256
+#define SLOT_AUTO_FEEDS_MASK ((1 << EEPROM_SLOT_AUTO_FEEDS_BITS) - 1)
+
+eepromImageStruct programEEPROM = {-1, NULL, NULL, NULL};
+
+/**
+ * Calculates the CRC32 of some bytes a bit at a time, the image is small enough that a table isn't needed.
+ *
+ * @param data The bytes to be checked.
+ * @param length How many bytes there are.
+ * @return The CRC32 of the bytes.
+ */
+uint32_t crc32(const void *data, const size_t length) {
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @param layout The image.
+ * @return The CRC32 of the settings pages, between the header and the slots.
+ */
+static uint32_t settingsCrc(const eepromLayoutStruct *layout) {
+    return crc32((const uint8_t *) layout + sizeof(eepromHeaderStruct),
+                 EEPROM_SLOTS_OFFSET - sizeof(eepromHeaderStruct));
+}
+
+/**
+ * Fills a slot and its CRC.
+ *
+ * @param warmStart The clock value.
+ * @param sequence The sequence number of the slot, never 0.
+ * @param autoFeedsDone The auto feeds done, up to 999.
+ * @param nextFeed The next feed, -1 if there isn't one.
+ * @return The slot.
+ */
+static eepromSlotStruct makeSlot(const int64_t warmStart, const uint16_t sequence, const int autoFeedsDone,
+                                 const int nextFeed) {
+    eepromSlotStruct slot = {
+        warmStart, sequence,
+        (uint16_t) ((autoFeedsDone & SLOT_AUTO_FEEDS_MASK) | ((nextFeed + 1) << EEPROM_SLOT_AUTO_FEEDS_BITS)), 0
+    };
+    slot.crc = crc32(&slot, offsetof(eepromSlotStruct, crc));
+    return slot;
+}
+
+/**
+ * @param slot A slot of the ring.
+ * @return The auto feeds done stored in the slot.
+ */
+static int slotAutoFeedsDone(const eepromSlotStruct *slot) {
+    return slot->counters & SLOT_AUTO_FEEDS_MASK;
+}
+
+/**
+ * @param slot A slot of the ring.
+ * @return The next feed stored in the slot, -1 if there isn't one.
+ */
+static int slotNextFeed(const eepromSlotStruct *slot) {
+    return (slot->counters >> EEPROM_SLOT_AUTO_FEEDS_BITS) - 1;
+}
+
+/**
+ * Finds the newest slot that was written whole. The sequence numbers wrap, so a slot is newer if it is less than half
+ * the range of sequence numbers ahead, which always holds within a ring much smaller than that.
+ *
+ * @param layout The image.
+ * @return The index of the slot, or -1 if no slot has been written.
+ */
+static int newestSlot(const eepromLayoutStruct *layout) {
+    int newest = -1;
+    for (int i = 0; i < EEPROM_SLOTS; i++) {
+        const eepromSlotStruct *slot = &layout->slots[i];
+        if (slot->sequence != 0 && slot->crc == crc32(slot, offsetof(eepromSlotStruct, crc)) &&
+            (newest < 0 || (int16_t) (slot->sequence - layout->slots[newest].sequence) > 0)) {
+            newest = i;
+        }
+    }
+    return newest;
+}
+
+/**
+ * Counts what a save costs the real EEPROM, which programs every page whose bytes changed once and whole.
+ *
+ * @param wear The wear counters.
+ * @param before The EEPROM before the save.
+ * @param after The EEPROM after the save.
+ */
+static void countPageWrites(eepromWearStruct *wear, const eepromLayoutStruct *before, const eepromLayoutStruct *after) {
+    const uint8_t *oldBytes = (const uint8_t *) before;
+    const uint8_t *newBytes = (const uint8_t *) after;
+    for (int page = 0; page < EEPROM_PAGES; page++) {
+        int changed = 0;
+        for (int i = page * EEPROM_PAGE_SIZE; i < (page + 1) * EEPROM_PAGE_SIZE; i++) {
+            changed += oldBytes[i] != newBytes[i];
+        }
+        if (changed > 0) {
+            wear->pageWrites[page]++;
+            wear->bytesChanged += changed;
+            wear->bytesProgrammed += EEPROM_PAGE_SIZE;
+        }
+    }
+}
+
+/**
+ * Writes a blank EEPROM with a header for the current layout, no feeds and no slots written.
+ *
+ * @param layout The bank to be formatted.
+ */
+static void formatLayout(eepromLayoutStruct *layout) {
+    memset(layout, 0, EEPROM_IMAGE_SIZE);
+    layout->header.magic = EEPROM_IMAGE_MAGIC;
+    layout->header.version = EEPROM_IMAGE_VERSION;
+    layout->header.size = EEPROM_IMAGE_SIZE;
+    layout->mode = 1;
+    layout->header.crc = settingsCrc(layout);
+}
+
+/**
+ * @param layout A bank of the image.
+ * @return If the bank has a header for the current layout and its settings pages match their CRC.
+ */
+static bool layoutIsValid(const eepromLayoutStruct *layout) {
+    return layout->header.magic == EEPROM_IMAGE_MAGIC && layout->header.version == EEPROM_IMAGE_VERSION &&
+           layout->header.size == EEPROM_IMAGE_SIZE && layout->header.crc == settingsCrc(layout);
+}
+
+/**
+ * @param image The image.
+ * @return The bank that isn't in use, which the next save is written to.
+ */
+static eepromLayoutStruct *otherBank(const eepromImageStruct *image) {
+    return &image->file->banks[image->layout == &image->file->banks[0] ? 1 : 0];
+}
+
+/**
+ * Writes a whole image file to a temporary file, syncs it and renames it over the image file.
+ *
+ * @param filename The name of the image file.
+ * @param file The contents of the image file.
+ * @return If the image file was replaced.
+ */
+static bool replaceImageFile(const char *filename, const eepromFileStruct *file) {
+    char temporaryFilename[FILENAME_BUFFER];
+    snprintf(temporaryFilename, FILENAME_BUFFER, "%s.tmp", filename);
+    const int fileDescriptor = open(temporaryFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    const bool written = write(fileDescriptor, file, sizeof(eepromFileStruct)) == (ssize_t) sizeof(eepromFileStruct) &&
+                         fsync(fileDescriptor) == 0;
+    close(fileDescriptor);
+    if (!written || rename(temporaryFilename, filename) != 0) {
+        remove(temporaryFilename);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Replaces an image file that isn't the size of the image, or is missing, with a blank image. A file of another size
+ * isn't an image this program wrote so nothing in it is kept.
+ *
+ * @param filename The name of the image file.
+ * @return If the image file was replaced.
+ */
+static bool createImageFile(const char *filename) {
+    eepromFileStruct created;
+    memset(&created, 0, sizeof(created));
+    created.wear.magic = EEPROM_WEAR_MAGIC;
+    formatLayout(&created.banks[0]);
+    return replaceImageFile(filename, &created);
+}
+
+/**
+ * Opens and maps an image file. A missing file, or one of the wrong size, is replaced with a blank image first so
+ * eepromImageLoad only fails on an image that was corrupted. If the bank in use is corrupt and the other bank isn't,
+ * the other bank is used.
+ *
+ * @param image The image to be opened.
+ * @param filename The name of the image file.
+ * @return If the image could be opened.
+ */
+bool openEEPROMImage(eepromImageStruct *image, const char *filename) {
+    image->file = NULL;
+    image->layout = NULL;
+    image->wear = NULL;
+    image->fileDescriptor = open(filename, O_RDWR | O_CREAT, 0644);
+    if (image->fileDescriptor < 0) {
+        printf("Error opening EEPROM image\n");
+        return false;
+    }
+    struct stat fileInformation;
+    if (fstat(image->fileDescriptor, &fileInformation) != 0) {
+        printf("Error reading EEPROM image\n");
+        close(image->fileDescriptor);
+        image->fileDescriptor = -1;
+        return false;
+    }
+    if (fileInformation.st_size != sizeof(eepromFileStruct)) {
+        close(image->fileDescriptor);
+        image->fileDescriptor = createImageFile(filename) ? open(filename, O_RDWR) : -1;
+        if (image->fileDescriptor < 0) {
+            printf("Error creating EEPROM image\n");
+            return false;
+        }
+    }
+    void *mapped = mmap(NULL, sizeof(eepromFileStruct), PROT_READ | PROT_WRITE, MAP_SHARED, image->fileDescriptor, 0);
+    if (mapped == MAP_FAILED) {
+        printf("Error mapping EEPROM image\n");
+        close(image->fileDescriptor);
+        image->fileDescriptor = -1;
+        return false;
+    }
+    image->file = mapped;
+    image->wear = &image->file->wear;
+    if (image->wear->magic != EEPROM_WEAR_MAGIC) {
+        memset(image->wear, 0, sizeof(eepromWearStruct));
+        image->wear->magic = EEPROM_WEAR_MAGIC;
+    }
+    image->layout = &image->file->banks[image->file->activeBank < EEPROM_BANKS ? image->file->activeBank : 0];
+    if (!layoutIsValid(image->layout) && layoutIsValid(otherBank(image))) {
+        image->layout = otherBank(image); //The bank in use was corrupted after it was switched to.
+    }
+    return true;
+}
+
+/**
+ * @param image The image.
+ * @return If the image is open.
+ */
+bool eepromImageIsOpen(const eepromImageStruct *image) {
+    return image->layout != NULL;
+}
+
+/**
+ * @param image The image.
+ * @return If nothing has been saved to the image since it was formatted.
+ */
+bool eepromImageIsBlank(const eepromImageStruct *image) {
+    return image->layout != NULL && image->layout->numberOfFeeds == 0 && newestSlot(image->layout) < 0;
+}
+
+/**
+ * Checks the header and every field of the image before copying it into an operating mode, so nothing read from the
+ * image can be out of range. If no slot has been written the operating mode has no next feed or auto feeds.
+ *
+ * @param image The image to be loaded.
+ * @param operatingMode Set to the operating mode in the image, left alone if the image is invalid.
+ * @param warmStartValue Set to the clock value in the image, left alone if the image is invalid.
+ * @return If the image was valid.
+ */
+bool eepromImageLoad(const eepromImageStruct *image, operatingModeStruct *operatingMode, long long *warmStartValue) {
+    const eepromLayoutStruct *layout = image->layout;
+    if (layout == NULL || !layoutIsValid(layout)) {
+        return false;
+    }
+    const int newest = newestSlot(layout);
+    const eepromSlotStruct empty = makeSlot(0, 0, 0, -1);
+    const eepromSlotStruct *slot = newest >= 0 ? &layout->slots[newest] : &empty;
+    const int nextFeed = slotNextFeed(slot);
+    const int autoFeedsDone = slotAutoFeedsDone(slot);
+    if (layout->mode > 1 || layout->numberOfFeeds > EEPROM_MAX_FEEDS || nextFeed >= layout->numberOfFeeds ||
+        autoFeedsDone > 999) {
+        return false;
+    }
+    timeStruct feedTimes[EEPROM_MAX_FEEDS];
+    for (int i = 0; i < layout->numberOfFeeds; i++) {
+        const eepromFeedRecordStruct *feed = &layout->feeds[i];
+        if (feed->hour > 23 || feed->minute > 59 || feed->rotations < 1 || feed->rotations > 9) {
+            return false;
+        }
+        initialiseTime(&feedTimes[i], feed->hour, feed->minute, feed->rotations);
+    }
+    initialiseOperatingMode(operatingMode, layout->mode, nextFeed, layout->numberOfFeeds, feedTimes, autoFeedsDone);
+    *warmStartValue = slot->warmStart;
+    return true;
+}
+
+/**
+ * Stores an operating mode in the image. The bank in use is copied to the other bank and the operating mode is written
+ * into the copy, the clock, next feed and auto feeds done go in the slot after the newest one. Each page that differs
+ * from the bank in use is counted as one write of the real EEPROM. Once the copy is on disk it becomes the bank in use.
+ *
+ * @param image The image to be written to.
+ * @param operatingMode The operating mode to be stored.
+ * @param warmStartValue The clock value to be stored.
+ * @return If the operating mode is in the image on disk.
+ */
+bool eepromImageStore(eepromImageStruct *image, const operatingModeStruct *operatingMode, const long long warmStartValue) {
+    if (image->layout == NULL) {
+        return false;
+    }
+    const eepromLayoutStruct *inUse = image->layout;
+    eepromLayoutStruct *layout = otherBank(image);
+    memcpy(layout, inUse, EEPROM_IMAGE_SIZE);
+    if (layout->header.magic != EEPROM_IMAGE_MAGIC || layout->header.version != EEPROM_IMAGE_VERSION ||
+        layout->header.size != EEPROM_IMAGE_SIZE) {
+        formatLayout(layout); //A corrupt header is replaced rather than written around.
+    }
+    image->wear->saves++;
+    layout->mode = (uint8_t) operatingMode->mode;
+    layout->numberOfFeeds = (uint8_t) operatingMode->numberOfFeedsInADay;
+    memset(layout->feeds, 0, sizeof(layout->feeds));
+    for (int i = 0; i < operatingMode->numberOfFeedsInADay && i < EEPROM_MAX_FEEDS; i++) {
+        layout->feeds[i].hour = (uint8_t) operatingMode->feedTimes[i].hour;
+        layout->feeds[i].minute = (uint8_t) operatingMode->feedTimes[i].minute;
+        layout->feeds[i].rotations = (uint8_t) operatingMode->feedTimes[i].rotations;
+    }
+    //Also covers settings bytes that were corrupted without anything changing.
+    layout->header.crc = settingsCrc(layout);
+
+    const int newest = newestSlot(layout);
+    uint16_t sequence = newest >= 0 ? (uint16_t) (layout->slots[newest].sequence + 1) : 1;
+    if (sequence == 0) {
+        sequence = 1; //0 marks a slot that has never been written.
+    }
+    const eepromSlotStruct slot = makeSlot(warmStartValue, sequence, operatingMode->autoFeedsDone,
+                                           operatingMode->nextFeed);
+    if (newest < 0 || slot.warmStart != layout->slots[newest].warmStart ||
+        slot.counters != layout->slots[newest].counters) {
+        layout->slots[(newest + 1) % EEPROM_SLOTS] = slot;
+    }
+    if (memcmp(layout, inUse, EEPROM_IMAGE_SIZE) == 0) {
+        return true; //Nothing has changed, so there is nothing to switch to.
+    }
+    countPageWrites(image->wear, inUse, layout);
+    //The copy must be on disk before it is switched to, the switch is a single aligned word.
+    if (!eepromImageFlush(image)) {
+        return false;
+    }
+    image->file->activeBank = layout == &image->file->banks[0] ? 0 : 1;
+    image->layout = layout;
+    return eepromImageFlush(image);
+}
+
+/**
+ * Waits for every change to the image to be written to disk.
+ *
+ * @param image The image.
+ * @return If the image was written.
+ */
+bool eepromImageFlush(const eepromImageStruct *image) {
+    return image->file != NULL && msync(image->file, sizeof(eepromFileStruct), MS_SYNC) == 0;
+}
+
+/**
+ * Prints how many times each page has been written, the write amplification (bytes programmed for each byte changed)
+ * and how many more saves like the ones so far the most worn page can take before reaching its endurance.
+ *
+ * @param image The image.
+ */
+void eepromWearReport(const eepromImageStruct *image) {
+    if (image->wear == NULL) {
+        return;
+    }
+    const eepromWearStruct *wear = image->wear;
+    uint32_t mostWrites = 0;
+    printf("EEPROM page writes:");
+    for (int page = 0; page < EEPROM_PAGES; page++) {
+        printf(" %u", wear->pageWrites[page]);
+        if (wear->pageWrites[page] > mostWrites) {
+            mostWrites = wear->pageWrites[page];
+        }
+    }
+    printf("\n");
+    printf("EEPROM saves: %u, bytes changed: %llu, bytes programmed: %llu, write amplification: %.2f\n", wear->saves,
+           (unsigned long long) wear->bytesChanged, (unsigned long long) wear->bytesProgrammed,
+           wear->bytesChanged > 0 ? (double) wear->bytesProgrammed / wear->bytesChanged : 0);
+    if (mostWrites > 0 && wear->saves > 0) {
+        printf("EEPROM endurance: about %.0f more saves before the most worn page reaches %d writes\n",
+               (double) (EEPROM_PAGE_ENDURANCE - mostWrites) * wear->saves / mostWrites, EEPROM_PAGE_ENDURANCE);
+    }
+}
+
+/**
+ * Writes the image to disk and unmaps it.
+ *
+ * @param image The image to be closed.
+ */
+void closeEEPROMImage(eepromImageStruct *image) {
+    if (image->file != NULL) {
+        eepromImageFlush(image);
+        munmap(image->file, sizeof(eepromFileStruct));
+        image->file = NULL;
+        image->layout = NULL;
+        image->wear = NULL;
+    }
+    if (image->fileDescriptor >= 0) {
+        close(image->fileDescriptor);
+        image->fileDescriptor = -1;
+    }
+}
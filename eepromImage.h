@@ -0,0 +1,129 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the EEPROM image, a fixed size binary file laid out like the EEPROM on the real fish feeder.
+*
+* The image is memory mapped so each field is read where it sits. The file holds two banks, each a whole copy of the
+* EEPROM, and the number of the bank in use. A save is written into the other bank, which is synced to disk before the
+* number of the bank in use is changed to it, so a save cut short by a crash leaves the bank in use as it was. The header
+* holds a magic number, the layout version, the size and a CRC32 of the settings pages, a bank that fails any of these
+* checks is never loaded, and if the bank in use fails them the other bank is used.
+*
+* Like the real EEPROM the image is split into pages and a save programs the whole of each page whose bytes changed,
+* once, so every page write is counted to work out the wear on the device. Settings that rarely change (the mode and the
+* schedule) have fixed pages. The values written on every save (the clock, the next feed and the auto feeds done) are
+* written to a ring of slots instead, each save goes to the next slot with the next sequence number so the wear is spread
+* over every slot page. On load the newest slot whose CRC32 matches is used.
+*
+* The wear counters are kept after the banks in the same file, they are part of the emulator not the device. A missing
+* file, or one of the wrong size, is replaced by a blank image written to a temporary file that is renamed over it.
+*/
+#ifndef EEPROM_IMAGE_HEADER
+#define EEPROM_IMAGE_HEADER
+#include <stdbool.h>
+#include <stdint.h>
+#include "operatingMode.h"
+
+#define EEPROM_IMAGE_MAGIC 0x48534946u //"FISH" when read as bytes.
+#define EEPROM_IMAGE_VERSION 1
+#define EEPROM_IMAGE_SIZE 512
+#define EEPROM_PAGE_SIZE 16
+#define EEPROM_PAGES (EEPROM_IMAGE_SIZE / EEPROM_PAGE_SIZE)
+#define EEPROM_PAGE_ENDURANCE 1000000 //How many times a page can be written before it may fail.
+#define EEPROM_MAX_FEEDS 9
+#define EEPROM_SLOTS 16
+#define EEPROM_SLOTS_OFFSET (EEPROM_IMAGE_SIZE - EEPROM_SLOTS * EEPROM_PAGE_SIZE)
+#define EEPROM_WEAR_MAGIC 0x52414557u //"WEAR" when read as bytes.
+#define EEPROM_BANKS 2
+#define EEPROM_SLOT_AUTO_FEEDS_BITS 10 //Enough for the most auto feeds done, 999.
+
+/**
+ * One feed of the schedule as it is stored in the image.
+ */
+typedef struct {
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t rotations;
+    uint8_t reserved;
+} eepromFeedRecordStruct;
+
+/**
+ * The header at the start of the image.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size; //The size of the EEPROM in bytes.
+    uint32_t crc; //CRC32 of the settings pages, from the end of the header to the start of the slots.
+    uint32_t reserved;
+} eepromHeaderStruct;
+
+/**
+ * A slot of the wear-levelled ring, one page long.
+ */
+typedef struct {
+    int64_t warmStart; //The clock value when the program saved.
+    uint16_t sequence; //One more than the previous slot, wrapping past 0 which is a slot that has never been written.
+    uint16_t counters; //The auto feeds done in the low bits and the next feed plus one above them.
+    uint32_t crc; //CRC32 of the rest of the slot, catches a slot cut short by a crash.
+} eepromSlotStruct;
+
+/**
+ * The layout of the whole EEPROM, every field is at a fixed offset.
+ */
+typedef struct {
+    eepromHeaderStruct header; //Page 0.
+    uint8_t mode; //Page 1.
+    uint8_t numberOfFeeds;
+    uint8_t reserved[EEPROM_PAGE_SIZE - 2];
+    eepromFeedRecordStruct feeds[EEPROM_MAX_FEEDS]; //Pages 2-4.
+    uint8_t unused[EEPROM_SLOTS_OFFSET - 68]; //Free for later versions of the layout.
+    eepromSlotStruct slots[EEPROM_SLOTS]; //The last 16 pages.
+} eepromLayoutStruct;
+
+_Static_assert(sizeof(eepromLayoutStruct) == EEPROM_IMAGE_SIZE, "The EEPROM layout must fill the image exactly");
+_Static_assert(sizeof(eepromSlotStruct) == EEPROM_PAGE_SIZE, "Each slot must fill exactly one page");
+
+/**
+ * How much the EEPROM has been written, kept after the EEPROM in the image file.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t saves; //How many times the program has saved.
+    uint64_t bytesChanged; //How many bytes had a new value.
+    uint64_t bytesProgrammed; //How many bytes the EEPROM had to program, a whole page for each page changed.
+    uint32_t pageWrites[EEPROM_PAGES];
+} eepromWearStruct;
+
+/**
+ * The mapped image file, the two banks of the EEPROM followed by its wear counters.
+ */
+typedef struct {
+    eepromLayoutStruct banks[EEPROM_BANKS];
+    uint32_t activeBank; //The bank in use, only changed once the other bank is on disk.
+    uint32_t reserved;
+    eepromWearStruct wear;
+} eepromFileStruct;
+
+/**
+ * An open image.
+ */
+typedef struct {
+    int fileDescriptor; //-1 when the image isn't open.
+    eepromFileStruct *file; //The mapped file.
+    eepromLayoutStruct *layout; //The bank in use.
+    eepromWearStruct *wear; //The mapped wear counters.
+} eepromImageStruct;
+
+extern eepromImageStruct programEEPROM; //The EEPROM of the feeder shown on the GUI.
+
+uint32_t crc32(const void *data, const size_t length); //The standard CRC32 used by zip and ethernet.
+bool openEEPROMImage(eepromImageStruct *image, const char *filename); //Maps the image, creating a blank one if needed.
+bool eepromImageIsOpen(const eepromImageStruct *image);
+bool eepromImageIsBlank(const eepromImageStruct *image); //If the image has never been saved to.
+bool eepromImageLoad(const eepromImageStruct *image, operatingModeStruct *operatingMode, long long *warmStartValue);
+bool eepromImageStore(eepromImageStruct *image, const operatingModeStruct *operatingMode, const long long warmStartValue);
+bool eepromImageFlush(const eepromImageStruct *image); //Waits for the image to be written to disk.
+void eepromWearReport(const eepromImageStruct *image); //Prints the writes to each page and the write amplification.
+void closeEEPROMImage(eepromImageStruct *image);
+#endif //EEPROM_IMAGE_HEADER
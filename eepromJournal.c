@@ -0,0 +1,238 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The EEPROM journal, appends each change to the operating mode to a file and replays them on load.
+*/
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "clockOffset.h"
+#include "eepromJournal.h"
+#include "programShutdown.h"
+#define RECORD_BUFFER 160
+#define MAX_FEEDS 9
+#define MAX_AUTO_FEEDS_DONE 999
+#define MAX_ROTATIONS 9
+
+eepromJournalStruct programJournal;
+
+/**
+ * Builds the name of the journal that goes with a saved file, which is the saved files name with ".journal" added.
+ *
+ * @param savedFilename The name of the saved file.
+ * @param journalFilename Set to the name of the journal, must hold JOURNAL_FILENAME_BUFFER characters.
+ */
+void journalFilenameFor(const char *savedFilename, char *journalFilename) {
+    snprintf(journalFilename, JOURNAL_FILENAME_BUFFER, "%s.journal", savedFilename);
+}
+
+/**
+ * Applies one record to an operating mode, records with any value out of range are rejected.
+ *
+ * @param record The record without its newline.
+ * @param operatingMode The operating mode the record is applied to.
+ * @param warmStartValue Set by W records.
+ * @return If the record was applied.
+ */
+static bool applyRecord(const char *record, operatingModeStruct *operatingMode, long long *warmStartValue) {
+    int value;
+    int offset;
+    switch (record[0]) {
+        case 'M':
+            if (sscanf(record + 1, "%d", &value) != 1 || value < 0 || value > 1) {
+                return false;
+            }
+            operatingMode->mode = value;
+            return true;
+        case 'N':
+            if (sscanf(record + 1, "%d", &value) != 1 || value < -1 || value >= MAX_FEEDS) {
+                return false;
+            }
+            operatingMode->nextFeed = value;
+            return true;
+        case 'A':
+            if (sscanf(record + 1, "%d", &value) != 1 || value < 0 || value > MAX_AUTO_FEEDS_DONE) {
+                return false;
+            }
+            operatingMode->autoFeedsDone = value;
+            return true;
+        case 'W':
+            return sscanf(record + 1, "%lld", warmStartValue) == 1;
+        case 'F': {
+            const char *position = record + 1;
+            if (sscanf(position, "%d%n", &value, &offset) != 1 || value < 0 || value > MAX_FEEDS) {
+                return false;
+            }
+            position += offset;
+            timeStruct feedTimes[MAX_FEEDS];
+            for (int i = 0; i < value; i++) {
+                if (sscanf(position, "%d %d %d%n", &feedTimes[i].rotations, &feedTimes[i].hour, &feedTimes[i].minute,
+                           &offset) != 3) {
+                    return false;
+                }
+                if (feedTimes[i].rotations < 1 || feedTimes[i].rotations > MAX_ROTATIONS || feedTimes[i].hour < 0 ||
+                    feedTimes[i].hour > 23 || feedTimes[i].minute < 0 || feedTimes[i].minute > 59) {
+                    return false;
+                }
+                position += offset;
+            }
+            //Only changed once the whole schedule has been read.
+            operatingMode->numberOfFeedsInADay = value;
+            memcpy(operatingMode->feedTimes, feedTimes, sizeof(timeStruct) * value);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Replays a journal on top of an operating mode read from its saved file. Replay stops at the first record that was
+ * cut short or can't be understood, since nothing after it can be trusted.
+ *
+ * @param journalFilename The name of the journal.
+ * @param operatingMode The operating mode the records are applied to.
+ * @param warmStartValue Set to the clock value of the last W record, left alone if there isn't one.
+ * @return How many records were applied.
+ */
+int replayJournal(const char *journalFilename, operatingModeStruct *operatingMode, long long *warmStartValue) {
+    FILE *file = fopen(journalFilename, "r");
+    if (file == NULL) {
+        return 0; //No journal means nothing has changed since the last save.
+    }
+    char record[RECORD_BUFFER];
+    int applied = 0;
+    while (fgets(record, RECORD_BUFFER, file) != NULL) {
+        const size_t length = strlen(record);
+        if (length == 0 || record[length - 1] != '\n') {
+            break;
+        }
+        record[length - 1] = '\0';
+        if (!applyRecord(record, operatingMode, warmStartValue)) {
+            break;
+        }
+        applied++;
+    }
+    fclose(file);
+    //The next feed has to point at a feed in the schedule that was replayed.
+    if (operatingMode->nextFeed >= operatingMode->numberOfFeedsInADay) {
+        operatingMode->nextFeed = operatingMode->numberOfFeedsInADay > 0 ? 0 : -1;
+    }
+    return applied;
+}
+
+/**
+ * Opens the journal of a saved file for the changes to an operating mode.
+ * The operating mode must already have been loaded from the saved file and its journal.
+ *
+ * @param journal The journal to be opened.
+ * @param savedFilename The name of the saved file.
+ * @param operatingMode The operating mode whose changes are journaled.
+ */
+void openJournal(eepromJournalStruct *journal, const char *savedFilename, operatingModeStruct *operatingMode) {
+    snprintf(journal->savedFilename, JOURNAL_FILENAME_BUFFER, "%s", savedFilename);
+    journalFilenameFor(savedFilename, journal->journalFilename);
+    journal->fileDescriptor = open(journal->journalFilename, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (journal->fileDescriptor < 0) {
+        printf("Error opening journal, changes will only be saved on exit\n");
+    }
+    journal->watched = operatingMode;
+    journal->journaled = *operatingMode;
+    journal->warmStart = clockOffset(); //The image gets this when the journal is compacted below.
+    journal->records = 0;
+    //Anything replayed from an old journal is folded into the saved file so the journal starts empty.
+    compactJournal(journal);
+}
+
+/**
+ * Compares the watched operating mode with the journaled copy and appends a record for each field that has changed.
+ * Called straight after the operating mode is changed, so a change is in the file before the program does anything
+ * else. The clock only has a record when it has been set, it keeps running with real time so its warm start value
+ * doesn't change otherwise. The records are written together and the system writes them to disk in the background,
+ * a write to the file survives the program being killed. The journal is compacted once it holds enough records.
+ * Nothing is done if the journal isn't open.
+ *
+ * @param journal The journal to be written to.
+ */
+void journalRecordChanges(eepromJournalStruct *journal) {
+    if (journal->watched == NULL) {
+        return;
+    }
+    const operatingModeStruct *current = journal->watched;
+    operatingModeStruct *journaled = &journal->journaled;
+    char records[RECORD_BUFFER * 5];
+    int length = 0;
+    int newRecords = 0;
+    if (current->mode != journaled->mode) {
+        length += snprintf(records + length, sizeof(records) - length, "M %d\n", current->mode);
+        newRecords++;
+    }
+    if (current->nextFeed != journaled->nextFeed) {
+        length += snprintf(records + length, sizeof(records) - length, "N %d\n", current->nextFeed);
+        newRecords++;
+    }
+    if (current->autoFeedsDone != journaled->autoFeedsDone) {
+        length += snprintf(records + length, sizeof(records) - length, "A %d\n", current->autoFeedsDone);
+        newRecords++;
+    }
+    if (current->numberOfFeedsInADay != journaled->numberOfFeedsInADay ||
+        memcmp(current->feedTimes, journaled->feedTimes, sizeof(timeStruct) * current->numberOfFeedsInADay) != 0) {
+        length += snprintf(records + length, sizeof(records) - length, "F %d", current->numberOfFeedsInADay);
+        for (int i = 0; i < current->numberOfFeedsInADay; i++) {
+            length += snprintf(records + length, sizeof(records) - length, " %d %d %d",
+                               current->feedTimes[i].rotations, current->feedTimes[i].hour, current->feedTimes[i].minute);
+        }
+        length += snprintf(records + length, sizeof(records) - length, "\n");
+        newRecords++;
+    }
+    const long long warmStart = clockOffset(); //Only asks the clock again after it has been set.
+    if (warmStart != journal->warmStart) {
+        length += snprintf(records + length, sizeof(records) - length, "W %lld\n", warmStart);
+        newRecords++;
+    }
+    if (newRecords == 0) {
+        return;
+    }
+    *journaled = *current;
+    journal->warmStart = warmStart;
+    if (journal->fileDescriptor >= 0 && write(journal->fileDescriptor, records, (size_t) length) != length) {
+        printf("Error writing journal\n");
+    }
+    journal->records += newRecords;
+    if (journal->records >= JOURNAL_COMPACT_RECORDS) {
+        compactJournal(journal);
+    }
+}
+
+/**
+ * Saves the watched operating mode to the EEPROM image and empties the journal. The journal is only emptied once the
+ * image has been written to disk.
+ *
+ * @param journal The journal to be compacted.
+ */
+void compactJournal(eepromJournalStruct *journal) {
+    if (!saveToEEPROM(journal->savedFilename, journal->watched)) {
+        return; //The journal is kept since the saved file is out of date.
+    }
+    journal->journaled = *journal->watched;
+    journal->warmStart = clockOffset(); //The value the image was just saved with.
+    journal->records = 0;
+    if (journal->fileDescriptor >= 0 && ftruncate(journal->fileDescriptor, 0) != 0) {
+        printf("Error emptying journal\n");
+    }
+}
+
+/**
+ * Saves the operating mode and closes the journal.
+ *
+ * @param journal The journal to be closed.
+ */
+void closeJournal(eepromJournalStruct *journal) {
+    compactJournal(journal);
+    if (journal->fileDescriptor >= 0) {
+        close(journal->fileDescriptor);
+        journal->fileDescriptor = -1;
+    }
+    journal->watched = NULL;
+}
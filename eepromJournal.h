@@ -0,0 +1,46 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the EEPROM journal, which makes every change to the operating mode survive the program being killed.
+*
+* Each change is appended to a journal file next to the EEPROM image as a short line of text, the code that finishes a
+* change calls journalRecordChanges straight away. The clock is only journaled when it has been set, since it keeps
+* running with real time its warm start value is read once and doesn't change otherwise. A schedule is only journaled once it is finished, so a half edited
+* schedule is never replayed. Once the journal holds enough records it is compacted, the operating mode is saved to the
+* image and the journal is emptied.
+* Loading reads the image and then replays the journal on top of it.
+*
+* Records are one letter, its values and a newline:
+* M mode, N nextFeed, A autoFeedsDone, W warmStart and F numberOfFeeds followed by rotations hour minute for each feed.
+* A record without its newline was cut short, and a record with any value out of range can't be trusted, so it and
+* anything after it is ignored.
+*/
+#ifndef EEPROM_JOURNAL_HEADER
+#define EEPROM_JOURNAL_HEADER
+#include "operatingMode.h"
+
+#define JOURNAL_FILENAME_BUFFER 256
+#define JOURNAL_COMPACT_RECORDS 64
+
+/**
+ * An open journal and the operating mode it is watching for changes.
+ */
+typedef struct {
+    char savedFilename[JOURNAL_FILENAME_BUFFER]; //The EEPROM image the journal is compacted into.
+    char journalFilename[JOURNAL_FILENAME_BUFFER];
+    int fileDescriptor; //The journal file opened for appending, -1 if it couldn't be opened.
+    operatingModeStruct *watched; //The operating mode the program is changing, NULL until the journal is opened.
+    operatingModeStruct journaled; //The operating mode as the saved file and journal hold it.
+    long long warmStart; //The clock value as the saved file and journal hold it.
+    int records; //How many records the journal holds.
+} eepromJournalStruct;
+
+extern eepromJournalStruct programJournal; //The journal of the operating mode shown on the GUI.
+
+void journalFilenameFor(const char *savedFilename, char *journalFilename); //The journal that goes with a saved file.
+int replayJournal(const char *journalFilename, operatingModeStruct *operatingMode, long long *warmStartValue);
+void openJournal(eepromJournalStruct *journal, const char *savedFilename, operatingModeStruct *operatingMode);
+void journalRecordChanges(eepromJournalStruct *journal); //Appends a record for each field that has changed.
+void compactJournal(eepromJournalStruct *journal); //Saves the operating mode and empties the journal.
+void closeJournal(eepromJournalStruct *journal); //Compacts the journal and closes it.
+#endif //EEPROM_JOURNAL_HEADER
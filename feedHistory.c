@@ -0,0 +1,223 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The feed history, a ring of fixed size records in a memory mapped file.
+*/
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "clockOffset.h"
+#include "feedHistory.h"
+
+feedHistoryStruct programHistory = {-1, NULL};
+
+/**
+ * Works out the feeders clock as a single number so events can be compared and grouped by day. It is real time plus
+ * the clocks offset, so it takes no round trip to the GUI and can't tear across a minute or day.
+ * The clock holds the local time so it is converted as if it were UTC, meaning days start at the feeders midnight.
+ *
+ * @return Seconds since the start of 1970 by the feeders clock.
+ */
+long long rtcTimestamp() {
+    const time_t feederTime = time(NULL) + (time_t) clockOffset();
+    struct tm clockTime;
+    localtime_r(&feederTime, &clockTime);
+    return (long long) timegm(&clockTime);
+}
+
+/**
+ * Opens and maps the log file, a missing file or one with a different layout is replaced with an empty log.
+ * If the log can't be opened the program carries on without one.
+ *
+ * @param history The log to be opened.
+ * @param filename The name of the log file.
+ */
+void openFeedHistory(feedHistoryStruct *history, const char *filename) {
+    history->file = NULL;
+    history->fileDescriptor = open(filename, O_RDWR | O_CREAT, 0644);
+    if (history->fileDescriptor < 0) {
+        printf("Error opening feed history\n");
+        return;
+    }
+    struct stat fileInformation;
+    const bool wrongSize = fstat(history->fileDescriptor, &fileInformation) != 0 ||
+                           fileInformation.st_size != sizeof(feedHistoryFileStruct);
+    if (wrongSize && ftruncate(history->fileDescriptor, sizeof(feedHistoryFileStruct)) != 0) {
+        close(history->fileDescriptor);
+        history->fileDescriptor = -1;
+        return;
+    }
+    void *mapped = mmap(NULL, sizeof(feedHistoryFileStruct), PROT_READ | PROT_WRITE, MAP_SHARED,
+                        history->fileDescriptor, 0);
+    if (mapped == MAP_FAILED) {
+        printf("Error mapping feed history\n");
+        close(history->fileDescriptor);
+        history->fileDescriptor = -1;
+        return;
+    }
+    history->file = mapped;
+    feedHistoryHeaderStruct *header = &history->file->header;
+    if (wrongSize || header->magic != FEED_HISTORY_MAGIC || header->version != FEED_HISTORY_VERSION ||
+        header->recordSize != sizeof(feedEventStruct) || header->capacity != FEED_HISTORY_CAPACITY) {
+        memset(history->file, 0, sizeof(feedHistoryFileStruct));
+        header->magic = FEED_HISTORY_MAGIC;
+        header->version = FEED_HISTORY_VERSION;
+        header->recordSize = sizeof(feedEventStruct);
+        header->capacity = FEED_HISTORY_CAPACITY;
+    }
+}
+
+/**
+ * Adds an event to the end of the log, overwriting the oldest event once the log is full.
+ * The record is written before the count so a reader never sees a record that is half written.
+ *
+ * @param history The log.
+ * @param timestamp When the event started, from rtcTimestamp.
+ * @param type What happened.
+ * @param rotations How many rotations were made, or would have been made.
+ * @param durationMs How long the motor turned for.
+ */
+void feedHistoryAppend(feedHistoryStruct *history, const long long timestamp, const feedEventType type,
+                       const int rotations, const long durationMs) {
+    if (history->file == NULL) {
+        return;
+    }
+    const feedEventStruct event = {timestamp, (uint32_t) durationMs, (uint8_t) type, (uint8_t) rotations, 0};
+    feedHistoryHeaderStruct *header = &history->file->header;
+    history->file->events[header->totalEvents % FEED_HISTORY_CAPACITY] = event;
+    header->totalEvents++;
+}
+
+/**
+ * @param history The log.
+ * @return How many events the log holds.
+ */
+static int eventsHeld(const feedHistoryStruct *history) {
+    if (history->file == NULL) {
+        return 0;
+    }
+    const uint64_t total = history->file->header.totalEvents;
+    return total < FEED_HISTORY_CAPACITY ? (int) total : FEED_HISTORY_CAPACITY;
+}
+
+/**
+ * Counts the events of one type in a time range.
+ *
+ * @param history The log.
+ * @param type The type of event counted.
+ * @param from The start of the range, included.
+ * @param to The end of the range, not included.
+ * @return How many events there were.
+ */
+int feedHistoryCount(const feedHistoryStruct *history, const feedEventType type, const long long from,
+                     const long long to) {
+    const int held = eventsHeld(history);
+    int count = 0;
+    for (int i = 0; i < held; i++) {
+        const feedEventStruct *event = &history->file->events[i];
+        if (event->type == type && event->timestamp >= from && event->timestamp < to) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Adds up the rotations of every feed in a time range.
+ *
+ * @param history The log.
+ * @param from The start of the range, included.
+ * @param to The end of the range, not included.
+ * @return How many rotations were made.
+ */
+int feedHistoryRotations(const feedHistoryStruct *history, const long long from, const long long to) {
+    const int held = eventsHeld(history);
+    int rotations = 0;
+    for (int i = 0; i < held; i++) {
+        const feedEventStruct *event = &history->file->events[i];
+        if ((event->type == FEED_EVENT_SCHEDULED || event->type == FEED_EVENT_MANUAL) && event->timestamp >= from &&
+            event->timestamp < to) {
+            rotations += event->rotations;
+        }
+    }
+    return rotations;
+}
+
+/**
+ * Works out the totals of each day in a run of days with one pass over the log.
+ *
+ * @param history The log.
+ * @param firstDay A timestamp in the first day.
+ * @param days How many days there are.
+ * @param totals Set to the totals of each day, must hold at least days entries.
+ */
+void feedHistoryDailyTotals(const feedHistoryStruct *history, const long long firstDay, const int days,
+                            feedDayTotalsStruct totals[]) {
+    memset(totals, 0, sizeof(feedDayTotalsStruct) * days);
+    const long long firstDayIndex = firstDay / SECONDS_IN_DAY;
+    const int held = eventsHeld(history);
+    for (int i = 0; i < held; i++) {
+        const feedEventStruct *event = &history->file->events[i];
+        const long long day = event->timestamp / SECONDS_IN_DAY - firstDayIndex;
+        if (day < 0 || day >= days) {
+            continue;
+        }
+        switch (event->type) {
+            case FEED_EVENT_SCHEDULED:
+            case FEED_EVENT_MANUAL:
+                totals[day].feeds++;
+                totals[day].rotations += event->rotations;
+                break;
+            case FEED_EVENT_SKIPPED:
+                totals[day].skipped++;
+                break;
+            case FEED_EVENT_MISSED:
+                totals[day].missed++;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * Prints the totals of each of the last few days by the feeders clock, newest first.
+ *
+ * @param history The log.
+ * @param days How many days are printed, at most 31.
+ */
+void feedHistoryPrintDays(const feedHistoryStruct *history, const int days) {
+    feedDayTotalsStruct totals[31];
+    const int shown = days < 31 ? days : 31;
+    const long long today = rtcTimestamp();
+    feedHistoryDailyTotals(history, today - (long long) (shown - 1) * SECONDS_IN_DAY, shown, totals);
+    for (int i = shown - 1; i >= 0; i--) {
+        const time_t dayStart = (time_t) ((today / SECONDS_IN_DAY - (shown - 1 - i)) * SECONDS_IN_DAY);
+        struct tm day;
+        gmtime_r(&dayStart, &day);
+        printf("%02d/%02d/%04d: %d feeds, %d rotations, %d skipped, %d missed\n", day.tm_mday, day.tm_mon + 1,
+               day.tm_year + 1900, totals[i].feeds, totals[i].rotations, totals[i].skipped, totals[i].missed);
+    }
+}
+
+/**
+ * Unmaps the log, the system finishes writing it to disk.
+ *
+ * @param history The log to be closed.
+ */
+void closeFeedHistory(feedHistoryStruct *history) {
+    if (history->file != NULL) {
+        munmap(history->file, sizeof(feedHistoryFileStruct));
+        history->file = NULL;
+    }
+    if (history->fileDescriptor >= 0) {
+        close(history->fileDescriptor);
+        history->fileDescriptor = -1;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the feed history, a log of every feed kept on disk for auditing.
+*
+* Each event is a fixed size record appended to a ring in a memory mapped file, once the ring is full the oldest records
+* are overwritten. Appending is a copy into the mapping, the system writes it to disk in the background so the feed path
+* never waits on the disk. The queries read the records straight from the mapping, nothing is parsed.
+*/
+#ifndef FEED_HISTORY_HEADER
+#define FEED_HISTORY_HEADER
+#include <stdint.h>
+
+#define FEED_HISTORY_MAGIC 0x54534948u //"HIST" when read as bytes.
+#define FEED_HISTORY_VERSION 1
+#define FEED_HISTORY_CAPACITY 8192 //Enough for nine feeds a day for over two years.
+#define SECONDS_IN_DAY 86400
+
+/**
+ * What happened.
+ */
+typedef enum {
+    FEED_EVENT_SCHEDULED, //A feed from the feed schedule.
+    FEED_EVENT_MANUAL, //A feed asked for by the user or a remote trigger.
+    FEED_EVENT_SKIPPED, //The user skipped the next feed.
+    FEED_EVENT_MISSED //A feed time passed while the feeder was paused.
+} feedEventType;
+
+/**
+ * One event in the log.
+ */
+typedef struct {
+    int64_t timestamp; //Seconds since 1970 by the feeders clock, when the event started.
+    uint32_t durationMs; //How long the motor turned for, 0 for events without a feed.
+    uint8_t type; //A feedEventType.
+    uint8_t rotations;
+    uint16_t reserved;
+} feedEventStruct;
+
+/**
+ * The start of the log file, followed by the ring of records.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t capacity; //How many records the ring holds.
+    uint32_t reserved;
+    uint64_t totalEvents; //How many events have ever been appended, the next is written at totalEvents % capacity.
+} feedHistoryHeaderStruct;
+
+/**
+ * The mapped log file.
+ */
+typedef struct {
+    feedHistoryHeaderStruct header;
+    feedEventStruct events[FEED_HISTORY_CAPACITY];
+} feedHistoryFileStruct;
+
+/**
+ * An open log.
+ */
+typedef struct {
+    int fileDescriptor; //-1 when the log isn't open.
+    feedHistoryFileStruct *file; //The mapped log.
+} feedHistoryStruct;
+
+/**
+ * The totals of one day.
+ */
+typedef struct {
+    int feeds; //Scheduled and manual feeds.
+    int rotations;
+    int skipped;
+    int missed;
+} feedDayTotalsStruct;
+
+extern feedHistoryStruct programHistory; //The feed history of the feeder shown on the GUI.
+
+long long rtcTimestamp(); //The feeders clock as seconds since 1970.
+void openFeedHistory(feedHistoryStruct *history, const char *filename); //Maps the log, creating it if needed.
+void feedHistoryAppend(feedHistoryStruct *history, const long long timestamp, const feedEventType type,
+                       const int rotations, const long durationMs);
+int feedHistoryCount(const feedHistoryStruct *history, const feedEventType type, const long long from,
+                     const long long to); //How many events of a type are in a time range.
+int feedHistoryRotations(const feedHistoryStruct *history, const long long from, const long long to);
+void feedHistoryDailyTotals(const feedHistoryStruct *history, const long long firstDay, const int days,
+                            feedDayTotalsStruct totals[]); //The totals of each day in a run of days.
+void feedHistoryPrintDays(const feedHistoryStruct *history, const int days); //Prints the totals of the last few days.
+void closeFeedHistory(feedHistoryStruct *history);
+#endif //FEED_HISTORY_HEADER
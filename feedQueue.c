@@ -0,0 +1,151 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The feed queue, the single consumer of feed requests that drives the motor controller.
+*/
+#include <stdio.h>
+#include "feedHistory.h"
+#include "feedQueue.h"
+#include "motorController.h"
+
+static feedQueueStruct queue;
+
+static void startNextJob(timerStruct *timer, void *context);
+
+/**
+ * Called by the motor controller when a job has finished. The feed is added to the feed history, as a scheduled feed if
+ * the schedule was one of the sources that asked for it, and the next job is started after the settle gap.
+ *
+ * @param context Unused.
+ */
+static void jobFinished(void *context) {
+    (void) context;
+    queue.turning = false;
+    const feedEventType type = queue.current.sources & FEED_SOURCE_SCHEDULE ? FEED_EVENT_SCHEDULED : FEED_EVENT_MANUAL;
+    feedHistoryAppend(&programHistory, queue.startedTimestamp, type, queue.current.rotations,
+                      (long) (monotonicMs() - queue.startedMs));
+    timerWheelAdd(&programTimers, &queue.settleTimer, FEED_SETTLE_MS);
+}
+
+/**
+ * Takes the highest priority request from the queue and gives it to the motor, if the motor is free.
+ *
+ * @param timer The settle timer, unused.
+ * @param context Unused.
+ */
+static void startNextJob(timerStruct *timer, void *context) {
+    (void) timer;
+    (void) context;
+    if (queue.turning || queue.numberWaiting == 0 || queue.settleTimer.pending) {
+        return;
+    }
+    int chosen = 0;
+    //Strictly greater so the oldest of equal priority requests is chosen.
+    for (int i = 1; i < queue.numberWaiting; i++) {
+        if (queue.waiting[i].priority > queue.waiting[chosen].priority) {
+            chosen = i;
+        }
+    }
+    queue.current = queue.waiting[chosen];
+    for (int i = chosen + 1; i < queue.numberWaiting; i++) {
+        queue.waiting[i - 1] = queue.waiting[i];
+    }
+    queue.numberWaiting--;
+    queue.turning = true;
+    queue.startedMs = monotonicMs();
+    queue.startedTimestamp = rtcTimestamp();
+    queue.stats.jobsStarted++;
+    queue.stats.rotationsDispensed += queue.current.rotations;
+    motorStartRotations(queue.current.rotations, jobFinished, NULL);
+}
+
+/**
+ * Merges a request into one that is already known about, the merged request makes the larger number of rotations.
+ * If the request being merged into is already turning the motor is given the extra rotations.
+ *
+ * @param existing The request being merged into.
+ * @param rotations How many rotations the new request wants.
+ * @param priority The priority of the new request.
+ * @param source The source of the new request.
+ */
+static void coalesceRequest(feedRequestStruct *existing, const int rotations, const feedPriority priority,
+                            const feedSource source) {
+    if (rotations > existing->rotations) {
+        if (existing == &queue.current) {
+            motorStartRotations(rotations - existing->rotations, NULL, NULL); //Added onto the job that is turning.
+            queue.stats.rotationsDispensed += rotations - existing->rotations;
+        }
+        existing->rotations = rotations;
+    }
+    if (priority > existing->priority) {
+        existing->priority = priority;
+    }
+    existing->sources |= source;
+    queue.stats.coalesced++;
+}
+
+/**
+ * Sets up an empty queue.
+ */
+void initialiseFeedQueue() {
+    queue.numberWaiting = 0;
+    queue.turning = false;
+    queue.stats = (feedQueueStatsStruct) {0, 0, 0, 0, 0};
+    initialiseTimer(&queue.settleTimer, startNextJob, NULL);
+}
+
+/**
+ * Asks for the fish to be fed. If a request is waiting or turning that arrived within the coalescing window the two are
+ * merged, otherwise the request is added to the queue. This returns straight away, the feed is made by the event loop.
+ *
+ * @param rotations How many whole rotations to make.
+ * @param priority How urgent the feed is.
+ * @param source What is asking for the feed.
+ * @return False if the queue is full and the request was dropped, otherwise true.
+ */
+bool feedQueueRequest(const int rotations, const feedPriority priority, const feedSource source) {
+    const long long nowMs = monotonicMs();
+    queue.stats.requested++;
+    if (queue.turning && nowMs - queue.current.requestedMs < FEED_COALESCE_WINDOW_MS) {
+        coalesceRequest(&queue.current, rotations, priority, source);
+        return true;
+    }
+    for (int i = 0; i < queue.numberWaiting; i++) {
+        if (nowMs - queue.waiting[i].requestedMs < FEED_COALESCE_WINDOW_MS) {
+            coalesceRequest(&queue.waiting[i], rotations, priority, source);
+            return true;
+        }
+    }
+    if (queue.numberWaiting == FEED_QUEUE_SIZE) {
+        queue.stats.rejected++;
+        printf("Feed queue full, a feed of %d rotations was dropped\n", rotations);
+        return false;
+    }
+    queue.waiting[queue.numberWaiting] = (feedRequestStruct) {rotations, priority, source, nowMs};
+    queue.numberWaiting++;
+    startNextJob(NULL, NULL);
+    return true;
+}
+
+/**
+ * @return If there are no requests waiting or turning.
+ */
+bool feedQueueIdle() {
+    return !queue.turning && queue.numberWaiting == 0;
+}
+
+/**
+ * Keeps running the event loop until every request has been fed. Used before the program exits so no feed is lost.
+ */
+void feedQueueWaitUntilIdle() {
+    while (!feedQueueIdle()) {
+        timerWheelRunFor(&programTimers, 100L);
+    }
+}
+
+/**
+ * @return The counts of what the queue has done.
+ */
+feedQueueStatsStruct feedQueueStats() {
+    return queue.stats;
+}
@@ -0,0 +1,77 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the feed queue, the only way feeds reach the motor controller.
+*
+* Every feed, whether it comes from the Feed Now option or the feed schedule, is added to a bounded queue with a
+* priority and the source that asked for it. A request that arrives within the coalescing window of one that is waiting
+* or turning is merged into it instead of being fed twice. The queue starts one job at a time once the motor is idle and
+* leaves a settle gap between jobs, which is the one place the dispensing rate is metered.
+*/
+#ifndef FEED_QUEUE_HEADER
+#define FEED_QUEUE_HEADER
+#include <stdbool.h>
+#include "timerWheel.h"
+
+#define FEED_QUEUE_SIZE 8
+#define FEED_COALESCE_WINDOW_MS 5000L
+#define FEED_SETTLE_MS 1000L
+
+/**
+ * What asked for a feed, a merged request keeps every source that asked for it.
+ */
+typedef enum {
+    FEED_SOURCE_MANUAL = 1, //The Feed Now option of the select operating mode menu.
+    FEED_SOURCE_SCHEDULE = 2 //A feed time in the feed schedule.
+} feedSource;
+
+/**
+ * Higher priorities are started first, requests with the same priority are started in the order they arrived.
+ */
+typedef enum {
+    FEED_PRIORITY_LOW,
+    FEED_PRIORITY_NORMAL,
+    FEED_PRIORITY_HIGH
+} feedPriority;
+
+/**
+ * A request to feed the fish.
+ */
+typedef struct {
+    int rotations; //How many whole rotations to make.
+    feedPriority priority;
+    int sources; //Every feedSource that asked for this feed.
+    long long requestedMs; //The monotonic time the first request arrived, the coalescing window starts here.
+} feedRequestStruct;
+
+/**
+ * Counts of what the queue has done, used to meter the dispensing hardware.
+ */
+typedef struct {
+    int requested; //How many requests were made.
+    int coalesced; //How many requests were merged into another.
+    int rejected; //How many requests were dropped because the queue was full.
+    int jobsStarted; //How many jobs were given to the motor.
+    int rotationsDispensed; //How many rotations those jobs made.
+} feedQueueStatsStruct;
+
+/**
+ * The queue of waiting requests in order of arrival and the request the motor is working on.
+ */
+typedef struct {
+    feedRequestStruct waiting[FEED_QUEUE_SIZE];
+    int numberWaiting;
+    feedRequestStruct current; //The request the motor is turning for.
+    bool turning; //If the current request is with the motor.
+    long long startedMs; //The monotonic time the current request started turning.
+    long long startedTimestamp; //The feeders clock when the current request started turning, for the feed history.
+    timerStruct settleTimer; //Fires when the next job can be started.
+    feedQueueStatsStruct stats;
+} feedQueueStruct;
+
+void initialiseFeedQueue(); //Sets up the queue, must be called after the motor controller is initialised.
+bool feedQueueRequest(const int rotations, const feedPriority priority, const feedSource source); //Asks for a feed.
+bool feedQueueIdle(); //If nothing is waiting or turning.
+void feedQueueWaitUntilIdle(); //Runs the event loop until every request has been fed.
+feedQueueStatsStruct feedQueueStats(); //The counts of what the queue has done.
+#endif //FEED_QUEUE_HEADER
@@ -0,0 +1,60 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The headless backend functions, these mimic the hardware functions in fish.c without using the GUI.
+*/
+#include "feederBackend.h"
+
+/**
+ * Initialises a backend with its clock offset from the host, the food container is filled.
+ *
+ * @param backend The backend to be initialised.
+ * @param rtcOffsetSeconds How many seconds the feeders clock is ahead of the hosts clock.
+ */
+void initialiseFeederBackend(feederBackendStruct *backend, const long long rtcOffsetSeconds) {
+    backend->rtcOffsetSeconds = rtcOffsetSeconds;
+    backend->motorSteps = 0;
+    backend->foodLevel = 50;
+}
+
+/**
+ * Gets the current time and date of the feeders clock, the clock keeps running because it is an offset from the host.
+ *
+ * @param backend The backend whose clock is read.
+ * @param now Set to the feeders current time and date.
+ */
+void backendClockNow(const feederBackendStruct *backend, struct tm *now) {
+    const time_t feederTime = time(NULL) + (time_t) backend->rtcOffsetSeconds;
+    localtime_r(&feederTime, now);
+}
+
+/**
+ * Sets the feeders clock by changing its offset from the host.
+ *
+ * @param backend The backend whose clock is set.
+ * @param clockTime The time and date the clock is set to.
+ */
+void backendClockSet(feederBackendStruct *backend, const struct tm *clockTime) {
+    struct tm newTime = *clockTime;
+    newTime.tm_isdst = -1; //Lets mktime work out daylight saving.
+    backend->rtcOffsetSeconds = (long long) (mktime(&newTime) - time(NULL));
+}
+
+/**
+ * Rotates the feeder container one step (1 degree).
+ *
+ * @param backend The backend whose motor is stepped.
+ */
+void backendMotorStep(feederBackendStruct *backend) {
+    backend->motorSteps++;
+}
+
+/**
+ * Sets the food level of the feeder.
+ *
+ * @param backend The backend that is filled.
+ * @param foodLevel The food level as a percentage, between 1 and 60.
+ */
+void backendFoodFill(feederBackendStruct *backend, const int foodLevel) {
+    backend->foodLevel = foodLevel;
+}
@@ -0,0 +1,25 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides a headless fish feeder backend, the hardware of a feeder that isn't shown on the GUI.
+* Each backend has its own real time clock offset, motor and food level so many can exist in one process.
+*/
+#ifndef FEEDER_BACKEND_HEADER
+#define FEEDER_BACKEND_HEADER
+#include <time.h>
+
+/**
+ * The hardware of one headless feeder.
+ */
+typedef struct {
+    long long rtcOffsetSeconds; //How far the feeders clock is from the hosts clock.
+    long long motorSteps; //How many steps the motor has made since the backend was initialised.
+    int foodLevel; //The food level as a percentage.
+} feederBackendStruct;
+
+void initialiseFeederBackend(feederBackendStruct *backend, const long long rtcOffsetSeconds);
+void backendClockNow(const feederBackendStruct *backend, struct tm *now); //Reads the feeders clock.
+void backendClockSet(feederBackendStruct *backend, const struct tm *clockTime); //Sets the feeders clock.
+void backendMotorStep(feederBackendStruct *backend); //Rotates the feeder one step (1 degree).
+void backendFoodFill(feederBackendStruct *backend, const int foodLevel); //Sets the food level.
+#endif //FEEDER_BACKEND_HEADER
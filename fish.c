@@ -49,6 +49,13 @@
 #include <pthread.h>
 
 #include "fish.h"
+#include "commandRecorder.h"
+#include "hardwareQueue.h"
+#include "inputScript.h"
+#include "jvmOptions.h"
+#include "scratchArena.h"
+#include "startupPipeline.h"
+#include "timerWheel.h"
 
 // it is possible to output various levels of debug info from the Fish GUI Emulator Java and C code
 // the following constants are used to select what to output to the console log.
@@ -66,7 +73,7 @@ int  log_level = 0; // global that stores the current log level setting
 
 JavaVM *vm;
 JNIEnv *env_fx; // jvm environment for JavaFX thread
-JNIEnv *env_c; // jvm environment for C processing thread
+JNIEnv *env_c; // jvm environment for the C bridge thread, the only C thread attached to the JVM
 
 // the java classes, methods and signatures type names we need
 // Note: to find method signature strings for a java class use jdk tool: javap -s -p FishFeederEmulator.class
@@ -99,12 +106,22 @@ jclass jclass_String = NULL; // java string class to pass strings to/from java m
 jclass jclass_Platform = NULL; // java fx Platform class
 jmethodID jmethod_platform_exit = NULL; // Platform.exit() method
 
-// thread management we need javaFX and C processing threads
-#define MAX_THREADS 2
+// the command names are made into java strings once, as global references, rather than for every command sent.
+// commands that have no arguments for the GUI send the same argument array every time, so that is made once too.
+// the whole numbers the display commands use, every coordinate and size, are made into java strings once as well.
+#define JNI_INTERNED_NUMBERS 256
+jstring jstring_command_names[COMMAND_OPCODES];
+jobjectArray jargs_without_arguments[COMMAND_OPCODES];
+jstring jstring_numbers[JNI_INTERNED_NUMBERS];
+
+// thread management we need javaFX, C bridge and C processing threads
+#define MAX_THREADS 3
 int threadCount = 0;
 pthread_t threads[MAX_THREADS];
 
 #define LINE_SIZE 200
+#define BRIDGE_LOCAL_FRAME 4 // the local references a request needs at once: arguments, an argument and a result
+#define GUI_READY_TIMEOUT_MS 30000L // how long the GUI has to become ready before startup fails
 
 /**
  * check for java exceptions passed back via the jni
@@ -178,23 +195,19 @@ bool isJavaFXReady(){
     return (bool)result;
 }
 
+static void bridgeSend(hardwareRequestStruct *request);
+static char *callMessage(int opcode, int numberOfInts, const long long ints[]);
+
 /**
- * create a new thread (creating a new env_c java thread environment)
- * to run the users C code with an entry point of userProcessing()
- * find the various JVM environment info classes and methods required for this thread
- * @param vargp
+ * the bridge thread (creating a new env_c java thread environment)
+ * this is the only C thread attached to the JVM, every fish.h function called on any thread
+ * queues a request that this thread sends to the JavaFX application (see hardwareQueue.h)
  * @return
  */
-void* createThread() {
-//    void* createThread(void * vargp) {
-    logAdd(METHOD_ENTRY, "createThread(). C processing thread starting");
-    char sb[LINE_SIZE]; // string buffer for messages
+void* bridgeThread() {
+    logAdd(METHOD_ENTRY, "bridgeThread(). C bridge thread starting");
 
-    // delay to allow the javaFX thread to initialise (otherwise we likely get an FX uninitialised exception)
-    logAdd(JNI_MESSAGES, "delay to allow JavaFX thread to start");
-    //sleep(FX_START_DELAY);
-
-    // get the java environment for the C processing thread note env_c is set by this call
+    // get the java environment for the bridge thread note env_c is set by this call
     int getEnvStat = (*vm)->GetEnv(vm, (void **) &env_c, JNI_VERSION_9); //TODO update JNI_VERSION_21
     logAdd(JNI_MESSAGES, "got java environment");
 
@@ -209,7 +222,7 @@ void* createThread() {
     if (getEnvStat == JNI_EDETACHED) {
         logAdd(JNI_MESSAGES, "getEnv: not attached. Attaching...");
         if ((*vm)->AttachCurrentThread(vm, (void **) &env_c, NULL) != 0) {
-            logAdd(JNI_MESSAGES, "processing thread. C: Failed to attach to Java VM");
+            logAdd(JNI_MESSAGES, "bridge thread. C: Failed to attach to Java VM");
             exit(1);
         }
     } else if (getEnvStat == JNI_OK) {
@@ -218,27 +231,58 @@ void* createThread() {
         logAdd(JNI_MESSAGES, "getEnv: version not supported");
     }
 
-    // hand over to do the users processing.
-    // This function should not return until the user code is done with the JFX GUI.
-    logAdd(JNI_MESSAGES, "start userProcessing()");
-
     // wait for JavaFX to be ready.
-    // TODO this simple code could hang so might need a timeout
+    // the GUI has no way to call into C so it is asked, the first checks are close together so a GUI that is
+    // nearly ready isn't waited on for long, backing off to 50ms to give the GUI thread time to do something!
+    // a GUI that never becomes ready fails startup rather than leaving the splash screen spinning
+    long readyPollMs = 1L;
+    long long readyBy = monotonicMs() + GUI_READY_TIMEOUT_MS;
     while (!isJavaFXReady()) {
         logAdd(JFX_MESSAGES, "JavaFX is not ready");
-        msleep(50L); // give the GUI thread time to do something!
+        if (monotonicMs() >= readyBy) {
+            logAdd(JFX_MESSAGES, "JavaFX didn't become ready in time");
+            printf("The GUI didn't become ready within %ldms\n", GUI_READY_TIMEOUT_MS);
+            exit(1);
+        }
+        msleep(readyPollMs);
+        if (readyPollMs < 50L) {
+            readyPollMs *= 2;
+        }
+    }
+    startupPhaseFinished(&programStartup, STARTUP_GUI); // signal the processing thread
+
+    // send the queued requests in the order they were queued, until the application exits
+    hardwareRequestStruct batch[HARDWARE_QUEUE_BATCH];
+    while (1) {
+        int taken = hardwareQueueTake(&programHardwareQueue, batch);
+        for (int i = 0; i < taken; i++) {
+            bridgeSend(&batch[i]);
+        }
     }
+}
+
+/**
+ * create a new thread to run the users C code with an entry point of userProcessing()
+ * this thread is not attached to the JVM, the hardware functions queue requests for the bridge thread
+ * @return
+ */
+void* createThread() {
+    logAdd(METHOD_ENTRY, "createThread(). C processing thread starting");
+
+    // wait for the bridge thread to signal that JavaFX is ready
+    startupWaitFor(&programStartup, STARTUP_GUI);
+
+    // hand over to do the users processing.
+    // This function should not return until the user code is done with the JFX GUI.
+    logAdd(JNI_MESSAGES, "start userProcessing()");
 
     // call the application (GUI users code, should not return until the application is finished)
     userProcessing();
     logAdd(JNI_MESSAGES, "returned from userProcessing()... finishing");
 
-    // tell the JFX to exit the process. This will also exit this C processing thread.
-    // it is a little ugly but Platform.exit can't detach when the calling thread is the main thread
-    // doing it this way also ensures that the C threads are killed when the JFX GUI is closed
-    snprintf(sb, LINE_SIZE, "calling java method %s.%s()", jclass_name_FishFeederEmulator, jmethod_name_emulator_exit);
-    logAdd(JNI_MESSAGES, sb);
-    (*env_c)->CallStaticVoidMethod(env_c, jclass_FishFeederEmulator, jmethod_exit, NULL);
+    // ask the bridge thread to tell the JFX to exit the process, once everything queued before it has been sent.
+    // This will also exit this C processing thread so the call never returns.
+    callMessage(HARDWARE_EXIT, 0, NULL);
 
     // clean up - we will never get here using jmethod_name_emulator_exit...
     /*
@@ -293,6 +337,34 @@ jclass getJavaClassReference(char const * const class_name) {
     return (*env_fx)->NewGlobalRef(env_fx, class);
 }
 
+/**
+ * make the java strings for the command names and the small whole numbers, and the argument arrays of the commands
+ * that have no arguments for the GUI, as global references using the env_fx thread environment (see hardwareCommands.h)
+ */
+void internCommands() {
+    for (int number = 0; number < JNI_INTERNED_NUMBERS; number++) {
+        char digits[4];
+        snprintf(digits, sizeof(digits), "%d", number);
+        jstring jstr = (*env_fx)->NewStringUTF(env_fx, digits);
+        jstring_numbers[number] = (*env_fx)->NewGlobalRef(env_fx, jstr);
+        (*env_fx)->DeleteLocalRef(env_fx, jstr);
+    }
+
+    for (int opcode = 0; opcode < COMMAND_OPCODES; opcode++) {
+        const hardwareCommandStruct *command = &hardwareCommands[opcode];
+        jstring name = (*env_fx)->NewStringUTF(env_fx, command->name);
+        jstring_command_names[opcode] = (*env_fx)->NewGlobalRef(env_fx, name);
+        (*env_fx)->DeleteLocalRef(env_fx, name);
+
+        jargs_without_arguments[opcode] = NULL;
+        if (command->numberOfInts + command->numberOfTexts == 0) {
+            jobjectArray jargs = (*env_fx)->NewObjectArray(env_fx, 1, jclass_String, jstring_command_names[opcode]);
+            jargs_without_arguments[opcode] = (*env_fx)->NewGlobalRef(env_fx, jargs);
+            (*env_fx)->DeleteLocalRef(env_fx, jargs);
+        }
+    }
+}
+
 /**
  * setup the JNI environment
  * this locates the Java classes and methods required for the C processing thread
@@ -305,13 +377,22 @@ int jniSetup() {
 
     logAdd(METHOD_ENTRY, "jniSetup(). Start JVM for nns.fishfeedergui");
 
-    // set up the JVM arguments
+    // set up the JVM arguments, main may already have added options to the GUI module option (see jvmOptions.h)
+    char sb[LINE_SIZE]; // string buffer for messages
+    if (programJvmOptions.count == 0) {
+        initialiseJvmOptions(&programJvmOptions);
+    }
     JavaVMInitArgs vm_args;
     vm_args.version = JNI_VERSION_9; // at least java 1.9
-    JavaVMOption options[1];
-    options[0].optionString = "-Djdk.module.main=nns.fishfeedergui";
+    JavaVMOption options[JVM_MAX_OPTIONS];
+    for (int i = 0; i < programJvmOptions.count; i++) {
+        options[i].optionString = programJvmOptions.options[i];
+        options[i].extraInfo = NULL;
+        snprintf(sb, LINE_SIZE, "JVM option %s", options[i].optionString);
+        logAdd(JNI_MESSAGES, sb);
+    }
     vm_args.options = options;
-    vm_args.nOptions = 1;
+    vm_args.nOptions = programJvmOptions.count;
     vm_args.ignoreUnrecognized = JNI_FALSE;
 
     // Create (and attach to) the JVM. note env_fx is set by this call
@@ -320,9 +401,11 @@ int jniSetup() {
 
     if (jvm_success != JNI_OK) {
         logAdd(JNI_MESSAGES, "Failed to create Java VM");
+        printf("Failed to create Java VM, check the options in %s\n", JVM_OPTIONS_VARIABLE);
         return 1;
     }
     logAdd(JNI_MESSAGES,"jvm successfully started");
+    startupPhaseFinished(&programStartup, STARTUP_JVM);
 
     // create a java global reference for the FishFeederEmulator class
     // note if we convert a jobject or jclass to a global reference they are valid in any thread (i.e. not only env_fx).
@@ -356,6 +439,13 @@ int jniSetup() {
     jmethod_isGUIReady = getJavaMethodReference(jclass_FishFeederEmulator, jclass_name_FishFeederEmulator,
                                                 jmethod_name_isGUIReady, jmethod_sig_isGUIReady);
 
+    // the command names and the argument arrays that never change
+    internCommands();
+
+    // Create the bridge thread, which attaches to the JVM and sends every hardware request to the GUI
+    threadCount++; //next available pthread_t item space
+    pthread_create(&threads[threadCount], NULL, bridgeThread, NULL); // thread_id, attr, function, function args
+
     // Create a new thread to run the C application code
     // This thread will run the users C code with an entry point of userProcessing()
     threadCount++; //next available pthread_t item space
@@ -385,9 +475,8 @@ int javaFx() {
     snprintf(sb, LINE_SIZE, "calling %s.%s()", jclass_name_FishFeederEmulator, jmethod_name_main);
     logAdd(JNI_MESSAGES,sb);
 
-    char *str = malloc(sizeof(char) * LINE_SIZE);
-    sprintf(str, "%d", log_level);
-    jstring jstr = (*env_fx)->NewStringUTF(env_fx, str);
+    jstring jstr = (*env_fx)->NewStringUTF(env_fx, scratchFormat(scratchArena(), "%d", log_level));
+    scratchReset(scratchArena());
     jobjectArray args = (*env_fx)->NewObjectArray(env_fx, 1, jclass_String, jstr); // 1 item
 
     (*env_fx)->CallStaticVoidMethod(env_fx, jclass_FishFeederEmulator, method_main, args);
@@ -424,15 +513,12 @@ void call_j_command (jobjectArray jargs) {
     (*env_c)->CallStaticObjectMethod(env_c, jclass_FishFeederEmulator, jmethod_command, jargs);
     exception_check(env_c, jmethod_name_command);
     logAdd(JNI_MESSAGES, "returned from java command function");
-
-    // release the local array reference
-    (*env_c)->DeleteLocalRef(env_c, jargs);
 }
 
 /**
  * send a message to the JavaFX application and get a response
  * @param message
- * @return the response message - memory needs freeing by caller
+ * @return the response message - in the bridge thread's scratch arena, it lasts until the arena is reset
  */
 char *call_j_message(jobjectArray jargs) {
     //logAdd(METHOD_ENTRY, "call_j_message()")
@@ -443,13 +529,10 @@ char *call_j_message(jobjectArray jargs) {
     exception_check(env_c, jmethod_name_message);
     logAdd(JNI_MESSAGES, "returned from java message function");
 
-    (*env_c)->DeleteLocalRef(env_c, jargs);
-
     // get the result string as a c string pointer from the java object
     const char *cstr_result = (*env_c)->GetStringUTFChars(env_c, jstr_result, NULL);
 
-    char *result = malloc(LINE_SIZE);
-    strcpy(result, cstr_result);
+    char *result = scratchFormat(scratchArena(), "%s", cstr_result);
     // release the java result string memory (must copy the string first if we want to keep it)
     (*env_c)->ReleaseStringUTFChars(env_c, jstr_result, cstr_result);
 
@@ -461,62 +544,141 @@ char *call_j_message(jobjectArray jargs) {
 }
 
 /**
- * create a list of jni arguments from a set of parameters
- * a format specifier must be used as the first parameter
- * s character signifies a string argument in the respective position
- * d character signifies a integer argument in the respective position
- * f character signifies a floating point type argument in the respective position
- * @param format
- * @param ...
- * @return a jni jobjectArray
- */
-jobjectArray build_args(char *format, ...) {
-    va_list args;
-    va_start(args, format);
-
-    // convert the parameters into strings that will be passed to the java method as an array of strings
-    jstring jstrs;
-
-    // init jni parameter list
-    jstring init = (*env_c)->NewStringUTF(env_c, "");
-    jobjectArray jargs = (*env_c)->NewObjectArray(env_c, (jsize)strlen(format), jclass_String, init); // 3 items
-
-    // process each parameter
-    char *str = malloc(sizeof(char) * LINE_SIZE);
-    int count = 0;
-    while (*format != '\0') {
-        switch (*format++) {
-            case 's':
-                sprintf(str, "%s", va_arg(args, const char *));
-                //fprintf(stdout, "string arg[%d]: %s\n", count, str);
-                jstrs = (*env_c)->NewStringUTF(env_c, str);
-                break;
-            case 'd':
-                sprintf(str, "%d", va_arg(args, int));
-                //fprintf(stdout, "string arg[%d]: %s\n", count, str);
-                jstrs = (*env_c)->NewStringUTF(env_c, str);
-                break;
-            case 'l':
-                sprintf(str, "%lld", va_arg(args, long long)); //nns updated 29/11/2024 change to long long (for Windows)
-                //fprintf(stdout, "string arg[%d]: %s\n", count, str);
-                jstrs = (*env_c)->NewStringUTF(env_c, str);
-                break;
-            case 'f':
-                sprintf(str, "%f", va_arg(args, double));
-                //fprintf(stdout, "string arg[%d]: %s\n", count, str);
-                jstrs = (*env_c)->NewStringUTF(env_c, str);
-                break;
+ * create the list of jni arguments for a request, laid out by the command table (see hardwareCommands.h)
+ * the array is made the exact size of the command's arguments, with the interned command name first.
+ * a whole number from 0 to 255 is an interned string, so a display command only makes its array
+ * must only be called on the bridge thread (env_c)
+ * @param request
+ * @return a jni jobjectArray, a local reference in the caller's local frame or a global reference to be left alone
+ */
+jobjectArray encode_args(const hardwareRequestStruct *request) {
+    if (jargs_without_arguments[request->opcode] != NULL) {
+        return jargs_without_arguments[request->opcode];
+    }
+
+    const hardwareCommandStruct *command = &hardwareCommands[request->opcode];
+    const int numberOfArguments = command->numberOfInts + command->numberOfTexts;
+    jobjectArray jargs = (*env_c)->NewObjectArray(env_c, 1 + numberOfArguments, jclass_String,
+                                                  jstring_command_names[request->opcode]);
+
+    // the texts go in before the whole number at textsAt
+    for (int argument = 0; argument < numberOfArguments; argument++) {
+        int text = argument - command->textsAt;
+        jstring jstr;
+        if (text >= 0 && text < command->numberOfTexts) {
+            jstr = (*env_c)->NewStringUTF(env_c, request->texts[text]);
+        } else {
+            long long whole = request->ints[text < 0 ? argument : argument - command->numberOfTexts];
+            if (whole >= 0 && whole < JNI_INTERNED_NUMBERS) {
+                // an interned number is a global reference, so it is set without making or deleting anything
+                (*env_c)->SetObjectArrayElement(env_c, jargs, argument + 1, jstring_numbers[whole]);
+                continue;
+            }
+            jstr = (*env_c)->NewStringUTF(env_c, scratchFormat(scratchArena(), "%lld", whole));
         }
-        // add the next jni parameter
-        (*env_c)->SetObjectArrayElement(env_c, jargs, count, jstrs);
-        (*env_c)->DeleteLocalRef(env_c, jstrs);
-        count += 1;
+        (*env_c)->SetObjectArrayElement(env_c, jargs, argument + 1, jstr);
+        (*env_c)->DeleteLocalRef(env_c, jstr);
     }
+    return jargs;
+}
 
-    free(str);
-    va_end(args);
+/**
+ * queue a command for the bridge thread to send to the JavaFX application
+ * the command isn't waited for, so the calling thread carries on while it is sent
+ * @param opcode the command
+ * @param numberOfInts the number of whole number arguments
+ * @param ints the whole number arguments
+ * @param numberOfTexts the number of text arguments
+ * @param texts the text arguments, these are copied
+ */
+static void sendCommand(commandOpcode opcode, int numberOfInts, const long long ints[], int numberOfTexts,
+                        const char *const texts[]) {
+    recordCommand(&programRecorder, opcode, numberOfInts, ints, numberOfTexts, texts);
+    hardwareRequestStruct request;
+    initialiseHardwareRequest(&request, opcode, numberOfInts, ints, numberOfTexts, texts);
+    hardwareQueueSend(&programHardwareQueue, &request);
+}
 
-    return jargs;
+/**
+ * queue a message for the bridge thread and wait for the response from the JavaFX application
+ * @param opcode the message (or HARDWARE_FLUSH / HARDWARE_EXIT)
+ * @param numberOfInts the number of whole number arguments
+ * @param ints the whole number arguments
+ * @return the response message - in the calling thread's scratch arena, the caller resets the arena when done with it
+ */
+static char *callMessage(int opcode, int numberOfInts, const long long ints[]) {
+    hardwareRequestStruct request;
+    hardwareFutureStruct future;
+    initialiseHardwareRequest(&request, opcode, numberOfInts, ints, 0, NULL);
+    hardwareQueueCall(&programHardwareQueue, &request, &future);
+    return scratchFormat(scratchArena(), "%s", future.result);
+}
+
+// a typed function for every command in the command table, send_<name>() for a command and call_<name>() for a
+// message, so the compiler checks the arguments of each command against its entry (see hardwareCommands.h)
+#define HARDWARE_SENDER(name, kind, parameters, numberOfInts, ints, numberOfTexts, texts, textsAt) \
+    kind##_SENDER(name, parameters, numberOfInts, ints, numberOfTexts, texts)
+#define HARDWARE_COMMAND_SENDER(name, parameters, numberOfInts, ints, numberOfTexts, texts) \
+    static inline void send_##name parameters { \
+        sendCommand(COMMAND_##name, numberOfInts, ints, numberOfTexts, texts); \
+    }
+#define HARDWARE_MESSAGE_SENDER(name, parameters, numberOfInts, ints, numberOfTexts, texts) \
+    static inline char *call_##name parameters { \
+        return callMessage(COMMAND_##name, numberOfInts, ints); \
+    }
+
+HARDWARE_COMMANDS(HARDWARE_SENDER)
+
+/**
+ * send a queued request to the JavaFX application, must only be called on the bridge thread (env_c)
+ * @param request
+ */
+static void bridgeSend(hardwareRequestStruct *request) {
+    char *result = NULL;
+
+    if (request->opcode == HARDWARE_FLUSH) {
+        // everything queued before the flush has been sent
+        hardwareQueueComplete(&programHardwareQueue, request->future, "");
+        return;
+    }
+    if (request->opcode == HARDWARE_EXIT) {
+        // tell the JFX to exit the process. This will also exit the C threads.
+        // it is a little ugly but Platform.exit can't detach when the calling thread is the main thread
+        // doing it this way also ensures that the C threads are killed when the JFX GUI is closed
+        char sb[LINE_SIZE];
+        snprintf(sb, LINE_SIZE, "calling java method %s.%s()", jclass_name_FishFeederEmulator, jmethod_name_emulator_exit);
+        logAdd(JNI_MESSAGES, sb);
+        (*env_c)->CallStaticVoidMethod(env_c, jclass_FishFeederEmulator, jmethod_exit, NULL);
+        return;
+    }
+
+    // every java object made for the request is released in one go when its local frame is popped,
+    // so the local reference table of the bridge thread doesn't grow however long the program runs
+    if ((*env_c)->PushLocalFrame(env_c, BRIDGE_LOCAL_FRAME) != 0) {
+        exception_check(env_c, "PushLocalFrame");
+        // there is no frame to pop, the request is dropped but a waiting sender is still woken
+        if (request->future != NULL) {
+            hardwareQueueComplete(&programHardwareQueue, request->future, "");
+        }
+        releaseHardwareRequest(request);
+        return;
+    }
+    jobjectArray jargs = encode_args(request);
+    switch (hardwareCommands[request->opcode].kind) {
+        case HARDWARE_COMMAND:
+            call_j_command(jargs);
+            break;
+        case HARDWARE_MESSAGE:
+            result = call_j_message(jargs);
+            break;
+    }
+
+    if (request->future != NULL) {
+        hardwareQueueComplete(&programHardwareQueue, request->future, result != NULL ? result : "");
+    }
+    (*env_c)->PopLocalFrame(env_c, NULL);
+    releaseHardwareRequest(request);
+    scratchReset(scratchArena());
 }
 
 /**
@@ -524,7 +686,7 @@ jobjectArray build_args(char *format, ...) {
  * to clear the display
  */
 void displayClear() {
-    call_j_command(build_args("s", "CLEAR_DISPLAY"));
+    send_CLEAR_DISPLAY();
 }
 
 /**
@@ -532,7 +694,7 @@ void displayClear() {
  * to step the motor
  */
 void motorStep() {
-    call_j_command(build_args("s", "MOTOR_STEP")); // 1st argument is format specifier
+    send_MOTOR_STEP();
 }
 
 /**
@@ -544,7 +706,7 @@ void motorStep() {
  * @param h
  */
 void displayClearArea(int x, int y, int w, int h) {
-    call_j_command(build_args("sdddd", "CLEAR_AREA", x, y, w, h)); // 1st argument is format specifier
+    send_CLEAR_AREA(x, y, w, h);
 }
 
 /**
@@ -556,7 +718,7 @@ void displayClearArea(int x, int y, int w, int h) {
  * @param h
  */
 void displayLine(int x, int y, int w, int h) {
-    call_j_command(build_args("sdddd", "LINE", x, y, w, h)); // 1st argument is format specifier
+    send_LINE(x, y, w, h);
 }
 
 /**
@@ -570,7 +732,7 @@ void displayLine(int x, int y, int w, int h) {
  * @param year
  */
 void clockSet(int sec, int min, int hour, int day, int month, int year) {
-    call_j_command(build_args("sdddddd", "SET_RTC", sec, min, hour, day, month, year)); // 1st argument is format specifier
+    send_SET_RTC(sec, min, hour, day, month, year);
 }
 
 /**
@@ -580,7 +742,7 @@ void clockSet(int sec, int min, int hour, int day, int month, int year) {
  * @param y
  */
 void displayPixel(int x, int y) {
-    call_j_command(build_args("sdd", "PIXEL", x, y)); // 1st argument is format specifier
+    send_PIXEL(x, y);
 }
 
 /**
@@ -589,7 +751,7 @@ void displayPixel(int x, int y) {
  * @param foodLevel
  */
 void foodFill(int foodLevel) {
-    call_j_command(build_args("sd", "FOOD", foodLevel)); // 1st argument is format specifier
+    send_FOOD(foodLevel);
 }
 
 /**
@@ -600,7 +762,7 @@ void foodFill(int foodLevel) {
  * @param size - 1 or 2 are the only two sizes currently supported on the real display
  */
 void displayText(int x, int y, char *text, int size) {
-    call_j_command(build_args("sddsd", "TEXTXY", x, y, text, size)); // 1st argument is format specifier
+    send_TEXTXY(x, y, text, size);
 }
 
 /**
@@ -608,7 +770,7 @@ void displayText(int x, int y, char *text, int size) {
  * @param text
  */
 void infoMessage(char *text) {
-    call_j_command(build_args("ss", "MESSAGE", text)); // 1st argument is format specifier
+    send_MESSAGE(text);
 }
 
 /**
@@ -622,7 +784,15 @@ void infoMessage(char *text) {
  * @param bg background colour
  */
 void displayColour(char *fg, char *bg) {
-    call_j_command(build_args("sss", "COLOUR", fg, bg)); // 1st argument is format specifier
+    send_COLOUR(fg, bg);
+}
+
+/**
+ * wait until every command queued so far has been sent to the JavaFX application
+ */
+void displayFlush() {
+    callMessage(HARDWARE_FLUSH, 0, NULL);
+    scratchReset(scratchArena());
 }
 
 /**
@@ -630,7 +800,15 @@ void displayColour(char *fg, char *bg) {
  * @return
  */
 char *buttonState() {
-    return call_j_message(build_args("s", "BUTTON")); // 1st argument is format specifier();
+    char *result;
+    if (inputScriptLoaded(&programInput)) {
+        result = inputScriptButtonState(&programInput); // the button is being pressed by an input script
+    } else {
+        result = strdup(call_BUTTON());
+        scratchReset(scratchArena());
+    }
+    recordCommand(&programRecorder, COMMAND_BUTTON, 0, NULL, 1, (const char *[]) {result});
+    return result;
 }
 
 /**
@@ -664,53 +842,55 @@ long long convertStringToLongLong(char *str) {
  * @return
  */
 long long clockWarmStart(long long offset) {
-    char *resultstr =  call_j_message(build_args("sl", "RTC_WARM_START", offset)); // 1st argument is format specifier();
+    char *resultstr = call_RTC_WARM_START(offset);
 
     printf("raw time offset: %s\n", resultstr);
+    recordCommand(&programRecorder, COMMAND_RTC_WARM_START, 1, (long long[]) {offset}, 1, (const char *[]) {resultstr});
 
     long long result = convertStringToLongLong(resultstr);
-    free(resultstr);
+    scratchReset(scratchArena());
     return result;
 }
 
 /**
  * send a time item message to the JavaFX application and get a response
- * @param item
+ * @param opcode the time item message
  * @return
  */
-int clockitem(char *item) {
-    char *resultstr =  call_j_message(build_args("s", item)); // 1st argument is format specifier();
+int clockitem(commandOpcode opcode) {
+    char *resultstr = callMessage(opcode, 0, NULL);
+    recordCommand(&programRecorder, opcode, 0, NULL, 1, (const char *[]) {resultstr});
     int result = (int)convertStringToLongLong(resultstr);
-    free(resultstr);
+    scratchReset(scratchArena());
     return result;
 }
 
 int clockSecond() {
-    return clockitem("RTC_SECOND");
+    return clockitem(COMMAND_RTC_SECOND);
 }
 
 int clockMinute() {
-    return clockitem("RTC_MINUTE");
+    return clockitem(COMMAND_RTC_MINUTE);
 }
 
 int clockHour() {
-    return clockitem("RTC_HOUR");
+    return clockitem(COMMAND_RTC_HOUR);
 }
 
 int clockDay() {
-    return clockitem("RTC_DAY");
+    return clockitem(COMMAND_RTC_DAY);
 }
 
 int clockMonth() {
-    return clockitem("RTC_MONTH")+1; // fix nns 29/11/2024 java starts months at 0=January
+    return clockitem(COMMAND_RTC_MONTH)+1; // fix nns 29/11/2024 java starts months at 0=January
 }
 
 int clockYear() {
-    return clockitem("RTC_YEAR");
+    return clockitem(COMMAND_RTC_YEAR);
 }
 
 int clockDayOfWeek() {
-    return clockitem("RTC_DAY_OF_WEEK")-1;
+    return clockitem(COMMAND_RTC_DAY_OF_WEEK)-1;
 }
 
 /**
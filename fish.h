@@ -11,6 +11,9 @@
  *
  * The utility functions section includes functions to set up the simulator
  * and control debug output (both in the GUI simulator debug area and on the console)
+ *
+ * The display, clock, feeder and button functions can be called from any thread. Display and feeder commands are
+ * queued and sent in order without waiting, clock and button functions wait for their result.
  */
 
 // display functions for the 128x64 OLED display
@@ -20,6 +23,7 @@ void displayText(int x, int y, char* text, int size); // pixel coordinates; size
 void displayPixel(int x, int y); // set an individual pixel;
 void displayLine(int x, int y, int x1, int y1); // draw a line between any two coordinates on the display
 void displayClearArea(int x, int y, int w, int h); // clear part of the display to the background colour
+void displayFlush(); // wait until every command sent so far has reached the display
 
 // real time clock (RTC) functions
 // set the clock.
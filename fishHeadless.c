@@ -0,0 +1,238 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* A headless version of the hardware functions in fish.c, the program runs without starting the JVM or the GUI.
+* The hardware is a feeder backend, nothing is drawn and the button is read from the input script if one is given.
+* This is used to run the program from scripts and for benchmarks. Commands are recorded like they are in fish.c, so a
+* headless run can be replayed on the GUI.
+*
+* Like fish.c the functions can be called from any thread, the backend is only used while its lock is held.
+*/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "commandRecorder.h"
+#include "feederBackend.h"
+#include "fish.h"
+#include "inputScript.h"
+#include "startupPipeline.h"
+
+const int THREAD_NAME = 1 << 0;
+const int THREAD_ID = 1 << 1;
+const int METHOD_ENTRY = 1 << 2;
+const int JNI_MESSAGES = 1 << 3;
+const int JFX_MESSAGES = 1 << 4;
+const int GENERAL = 1 << 5;
+const int STACK_INFO = 1 << 6;
+const int GUI_INFO_DEBUG = 1 << 7;
+
+int log_level = 0;
+
+static feederBackendStruct hardware; //The hardware of the feeder.
+static pthread_mutex_t hardwareLock = PTHREAD_MUTEX_INITIALIZER; //Held while the backend is used.
+
+/**
+ * Records the result of a message that returns a number.
+ *
+ * @param opcode The message.
+ * @param value Its result.
+ * @return The result.
+ */
+static int recordResult(const commandOpcode opcode, const int value) {
+    if (commandRecorderActive(&programRecorder)) {
+        char result[16];
+        snprintf(result, sizeof(result), "%d", value);
+        recordCommand(&programRecorder, opcode, 0, NULL, 1, (const char *[]) {result});
+    }
+    return value;
+}
+
+//DISPLAY FUNCTIONS, there is no display so nothing is drawn.
+void displayClear() {
+    recordCommand(&programRecorder, COMMAND_CLEAR_DISPLAY, 0, NULL, 0, NULL);
+}
+
+void displayColour(char *fg, char *bg) {
+    recordCommand(&programRecorder, COMMAND_COLOUR, 0, NULL, 2, (const char *[]) {fg, bg});
+}
+
+void displayText(int x, int y, char *text, int size) {
+    recordCommand(&programRecorder, COMMAND_TEXTXY, 3, (long long[]) {x, y, size}, 1, (const char *[]) {text});
+}
+
+void displayPixel(int x, int y) {
+    recordCommand(&programRecorder, COMMAND_PIXEL, 2, (long long[]) {x, y}, 0, NULL);
+}
+
+void displayLine(int x, int y, int x1, int y1) {
+    recordCommand(&programRecorder, COMMAND_LINE, 4, (long long[]) {x, y, x1, y1}, 0, NULL);
+}
+
+void displayClearArea(int x, int y, int w, int h) {
+    recordCommand(&programRecorder, COMMAND_CLEAR_AREA, 4, (long long[]) {x, y, w, h}, 0, NULL);
+}
+
+void displayFlush() {
+}
+
+//REAL TIME CLOCK FUNCTIONS
+/**
+ * Sets the feeders clock.
+ */
+void clockSet(int sec, int min, int hour, int day, int month, int year) {
+    recordCommand(&programRecorder, COMMAND_SET_RTC, 6, (long long[]) {sec, min, hour, day, month, year}, 0, NULL);
+    struct tm clockTime = {0};
+    clockTime.tm_sec = sec;
+    clockTime.tm_min = min;
+    clockTime.tm_hour = hour;
+    clockTime.tm_mday = day;
+    clockTime.tm_mon = month - 1;
+    clockTime.tm_year = year - 1900;
+    pthread_mutex_lock(&hardwareLock);
+    backendClockSet(&hardware, &clockTime);
+    pthread_mutex_unlock(&hardwareLock);
+}
+
+/**
+ * @return The feeders current time and date.
+ */
+static struct tm clockNow() {
+    struct tm now;
+    pthread_mutex_lock(&hardwareLock);
+    backendClockNow(&hardware, &now);
+    pthread_mutex_unlock(&hardwareLock);
+    return now;
+}
+
+int clockSecond() {
+    return recordResult(COMMAND_RTC_SECOND, clockNow().tm_sec);
+}
+
+int clockMinute() {
+    return recordResult(COMMAND_RTC_MINUTE, clockNow().tm_min);
+}
+
+int clockHour() {
+    return recordResult(COMMAND_RTC_HOUR, clockNow().tm_hour);
+}
+
+int clockDay() {
+    return recordResult(COMMAND_RTC_DAY, clockNow().tm_mday);
+}
+
+int clockMonth() {
+    return recordResult(COMMAND_RTC_MONTH, clockNow().tm_mon) + 1; //Recorded like the GUI, which starts at 0.
+}
+
+int clockYear() {
+    return recordResult(COMMAND_RTC_YEAR, clockNow().tm_year + 1900);
+}
+
+int clockDayOfWeek() {
+    return recordResult(COMMAND_RTC_DAY_OF_WEEK, clockNow().tm_wday);
+}
+
+/**
+ * Like the GUI the warm start value is the clocks offset from real time.
+ *
+ * @param offset 0 to get the offset, or a value got before to restore it.
+ * @return The clocks offset.
+ */
+long long clockWarmStart(long long offset) {
+    pthread_mutex_lock(&hardwareLock);
+    if (offset != 0) {
+        hardware.rtcOffsetSeconds = offset;
+    }
+    const long long rtcOffsetSeconds = hardware.rtcOffsetSeconds;
+    pthread_mutex_unlock(&hardwareLock);
+    if (commandRecorderActive(&programRecorder)) {
+        char result[24];
+        snprintf(result, sizeof(result), "%lld", rtcOffsetSeconds);
+        recordCommand(&programRecorder, COMMAND_RTC_WARM_START, 1, (long long[]) {offset}, 1, (const char *[]) {result});
+    }
+    return rtcOffsetSeconds;
+}
+
+//MECHANICAL FEEDER FUNCTIONS
+void motorStep() {
+    recordCommand(&programRecorder, COMMAND_MOTOR_STEP, 0, NULL, 0, NULL);
+    pthread_mutex_lock(&hardwareLock);
+    backendMotorStep(&hardware);
+    pthread_mutex_unlock(&hardwareLock);
+}
+
+void foodFill(int foodLevel) {
+    recordCommand(&programRecorder, COMMAND_FOOD, 1, (long long[]) {foodLevel}, 0, NULL);
+    pthread_mutex_lock(&hardwareLock);
+    backendFoodFill(&hardware, foodLevel);
+    pthread_mutex_unlock(&hardwareLock);
+}
+
+//BUTTON FUNCTION
+/**
+ * @return The button press from the input script, or "NO_PRESS" if there isn't a script. The caller must free it.
+ */
+char *buttonState() {
+    char *result;
+    if (inputScriptLoaded(&programInput)) {
+        result = inputScriptButtonState(&programInput);
+    } else {
+        result = malloc(12);
+        strcpy(result, "NO_PRESS");
+    }
+    recordCommand(&programRecorder, COMMAND_BUTTON, 0, NULL, 1, (const char *[]) {result});
+    return result;
+}
+
+//UTILITY FUNCTIONS
+void infoMessage(char *text) {
+    recordCommand(&programRecorder, COMMAND_MESSAGE, 0, NULL, 1, (const char *[]) {text});
+    logAdd(GUI_INFO_DEBUG, text);
+}
+
+/**
+ * There is no JVM or GUI to set up so the program is run straight away.
+ *
+ * @return 0
+ */
+int jniSetup() {
+    initialiseFeederBackend(&hardware, 0);
+    startupPhaseFinished(&programStartup, STARTUP_JVM);
+    startupPhaseFinished(&programStartup, STARTUP_GUI);
+    userProcessing();
+    return 0;
+}
+
+/**
+ * There is no GUI to hand the thread over to.
+ *
+ * @return 0
+ */
+int javaFx() {
+    return 0;
+}
+
+int msleep(long msec) {
+    if (msec < 0) {
+        return -1;
+    }
+    struct timespec sleepTime = {msec / 1000, (msec % 1000) * 1000000};
+    return nanosleep(&sleepTime, &sleepTime);
+}
+
+void logAddInfo(int level) {
+    log_level = log_level | level;
+}
+
+void logRemoveInfo(int level) {
+    log_level = log_level & ~level;
+}
+
+void logAdd(int level, char *message) {
+    if ((level & log_level) > 0) {
+        printf("C:    %s\n", message);
+        fflush(stdout);
+    }
+}
@@ -0,0 +1,21 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the display's font, the printable ASCII characters as 5x7 glyphs in a 6x8 cell, the same size
+* as the GUI's font so text takes the same place in the framebuffer as it does on the GUI.
+*
+* Each glyph is 5 columns, bit n of a column is the pixel n rows down, the sixth column and any row below the glyph
+* are the gap to the next character, the same layout as a column of an SSD1306 page.
+*/
+#ifndef FONT_HEADER
+#define FONT_HEADER
+#include <stdint.h>
+
+#define FONT_FIRST_CHARACTER ' '
+#define FONT_LAST_CHARACTER '~'
+#define FONT_GLYPH_WIDTH 5
+#define FONT_CHARACTER_WIDTH 6 //The glyph and the gap after it.
+#define FONT_CHARACTER_HEIGHT 8
+
+const uint8_t *fontGlyph(const char character); //The columns of a character's glyph, '?' if it has none.
+#endif //FONT_HEADER
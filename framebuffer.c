@@ -0,0 +1,297 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The framebuffer, the display in memory and the primitives that draw into it.
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "font.h"
+#include "framebuffer.h"
+
+/**
+ * What a span does to the pixels it covers.
+ */
+typedef enum {
+    SPAN_CLEAR,
+    SPAN_SET,
+    SPAN_INVERT
+} spanOperation;
+
+/**
+ * @param from The first bit.
+ * @param to The last bit, from 0 to 31.
+ * @return A word with the bits from the first to the last bit set.
+ */
+static uint32_t spanMask(const int from, const int to) {
+    const uint32_t upTo = to == FRAMEBUFFER_WORD_BITS - 1 ? UINT32_MAX : (UINT32_C(1) << (to + 1)) - 1;
+    return upTo & ~((UINT32_C(1) << from) - 1);
+}
+
+/**
+ * Applies an operation to part of a row a word at a time, the part is clipped to the display.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The first column.
+ * @param x1 The last column, can be before the first.
+ * @param y The row.
+ * @param operation What is done to the pixels.
+ */
+static void applySpan(framebufferStruct *framebuffer, int x, int x1, const int y, const spanOperation operation) {
+    if (x > x1) {
+        const int swap = x;
+        x = x1;
+        x1 = swap;
+    }
+    if (y < 0 || y >= FRAMEBUFFER_HEIGHT || x1 < 0 || x >= FRAMEBUFFER_WIDTH) {
+        return;
+    }
+    x = x < 0 ? 0 : x;
+    x1 = x1 >= FRAMEBUFFER_WIDTH ? FRAMEBUFFER_WIDTH - 1 : x1;
+    uint32_t *row = framebuffer->rows[y];
+    const int firstWord = x / FRAMEBUFFER_WORD_BITS;
+    const int lastWord = x1 / FRAMEBUFFER_WORD_BITS;
+    for (int word = firstWord; word <= lastWord; word++) {
+        //Only the end words need a mask, the words between are done whole.
+        const int from = word == firstWord ? x % FRAMEBUFFER_WORD_BITS : 0;
+        const int to = word == lastWord ? x1 % FRAMEBUFFER_WORD_BITS : FRAMEBUFFER_WORD_BITS - 1;
+        const uint32_t mask = spanMask(from, to);
+        switch (operation) {
+            case SPAN_CLEAR:
+                row[word] &= ~mask;
+                break;
+            case SPAN_SET:
+                row[word] |= mask;
+                break;
+            case SPAN_INVERT:
+                row[word] ^= mask;
+                break;
+        }
+    }
+}
+
+/**
+ * Clears every pixel to the background.
+ *
+ * @param framebuffer The framebuffer.
+ */
+void framebufferClear(framebufferStruct *framebuffer) {
+    memset(framebuffer->rows, 0, sizeof(framebuffer->rows));
+}
+
+/**
+ * @param framebuffer The framebuffer.
+ * @param x The column of the pixel.
+ * @param y The row of the pixel.
+ * @return If the pixel is in the foreground, false if it is off the display.
+ */
+bool framebufferGet(const framebufferStruct *framebuffer, const int x, const int y) {
+    if (x < 0 || x >= FRAMEBUFFER_WIDTH || y < 0 || y >= FRAMEBUFFER_HEIGHT) {
+        return false;
+    }
+    return (framebuffer->rows[y][x / FRAMEBUFFER_WORD_BITS] >> (x % FRAMEBUFFER_WORD_BITS)) & 1;
+}
+
+/**
+ * Sets or clears a pixel.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The column of the pixel.
+ * @param y The row of the pixel.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferPixel(framebufferStruct *framebuffer, const int x, const int y, const bool set) {
+    applySpan(framebuffer, x, x, y, set ? SPAN_SET : SPAN_CLEAR);
+}
+
+/**
+ * Sets or clears the pixels of a row between two columns, both included.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The first column.
+ * @param x1 The last column.
+ * @param y The row.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferSpan(framebufferStruct *framebuffer, const int x, const int x1, const int y, const bool set) {
+    applySpan(framebuffer, x, x1, y, set ? SPAN_SET : SPAN_CLEAR);
+}
+
+/**
+ * Sets or clears the pixels of a column between two rows, both included.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The column.
+ * @param y The first row.
+ * @param y1 The last row.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferVerticalSpan(framebufferStruct *framebuffer, const int x, const int y, const int y1, const bool set) {
+    const int top = y < y1 ? y : y1;
+    const int bottom = y < y1 ? y1 : y;
+    for (int row = top; row <= bottom; row++) {
+        applySpan(framebuffer, x, x, row, set ? SPAN_SET : SPAN_CLEAR);
+    }
+}
+
+/**
+ * Draws a line between two points, both included, using Bresenham's algorithm.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The start column.
+ * @param y The start row.
+ * @param x1 The end column.
+ * @param y1 The end row.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferLine(framebufferStruct *framebuffer, int x, int y, const int x1, const int y1, const bool set) {
+    if (y == y1) {
+        framebufferSpan(framebuffer, x, x1, y, set);
+        return;
+    }
+    if (x == x1) {
+        framebufferVerticalSpan(framebuffer, x, y, y1, set);
+        return;
+    }
+    const int dx = abs(x1 - x);
+    const int dy = -abs(y1 - y);
+    const int stepX = x < x1 ? 1 : -1;
+    const int stepY = y < y1 ? 1 : -1;
+    int error = dx + dy;
+    while (1) {
+        framebufferPixel(framebuffer, x, y, set);
+        if (x == x1 && y == y1) {
+            break;
+        }
+        const int doubleError = 2 * error;
+        if (doubleError >= dy) {
+            error += dy;
+            x += stepX;
+        }
+        if (doubleError <= dx) {
+            error += dx;
+            y += stepY;
+        }
+    }
+}
+
+/**
+ * Draws the outline of a rectangle between two corners, both included.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param x1 The right of the rectangle.
+ * @param y1 The bottom of the rectangle.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferRectangle(framebufferStruct *framebuffer, const int x, const int y, const int x1, const int y1,
+                          const bool set) {
+    framebufferSpan(framebuffer, x, x1, y, set);
+    framebufferSpan(framebuffer, x, x1, y1, set);
+    framebufferVerticalSpan(framebuffer, x, y, y1, set);
+    framebufferVerticalSpan(framebuffer, x1, y, y1, set);
+}
+
+/**
+ * Sets or clears every pixel of a rectangle.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param w The width of the rectangle.
+ * @param h The height of the rectangle.
+ * @param set True for the foreground, false for the background.
+ */
+void framebufferFillRectangle(framebufferStruct *framebuffer, const int x, const int y, const int w, const int h,
+                              const bool set) {
+    if (w <= 0) {
+        return;
+    }
+    for (int row = y; row < y + h; row++) {
+        applySpan(framebuffer, x, x + w - 1, row, set ? SPAN_SET : SPAN_CLEAR);
+    }
+}
+
+/**
+ * Swaps the foreground and background of every pixel of a rectangle.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param w The width of the rectangle.
+ * @param h The height of the rectangle.
+ */
+void framebufferInvert(framebufferStruct *framebuffer, const int x, const int y, const int w, const int h) {
+    if (w <= 0) {
+        return;
+    }
+    for (int row = y; row < y + h; row++) {
+        applySpan(framebuffer, x, x + w - 1, row, SPAN_INVERT);
+    }
+}
+
+/**
+ * Finds the runs of foreground pixels on part of a row, so the row can be drawn with one line per run. Words with no
+ * foreground pixels are skipped whole.
+ *
+ * @param framebuffer The framebuffer.
+ * @param y The row.
+ * @param x The first column looked at.
+ * @param x1 The last column looked at.
+ * @param starts Set to the first column of each run, must have room for FRAMEBUFFER_WIDTH / 2 runs.
+ * @param ends Set to the last column of each run.
+ * @return How many runs there are.
+ */
+int framebufferRowRuns(const framebufferStruct *framebuffer, const int y, const int x, const int x1, int starts[],
+                       int ends[]) {
+    if (y < 0 || y >= FRAMEBUFFER_HEIGHT) {
+        return 0;
+    }
+    const int first = x < 0 ? 0 : x;
+    const int last = x1 >= FRAMEBUFFER_WIDTH ? FRAMEBUFFER_WIDTH - 1 : x1;
+    int runs = 0;
+    bool inRun = false;
+    for (int column = first; column <= last; column++) {
+        const uint32_t word = framebuffer->rows[y][column / FRAMEBUFFER_WORD_BITS];
+        if (!inRun && word == 0) {
+            //Nothing starts in the rest of this word.
+            column |= FRAMEBUFFER_WORD_BITS - 1;
+            continue;
+        }
+        const bool set = (word >> (column % FRAMEBUFFER_WORD_BITS)) & 1;
+        if (set && !inRun) {
+            starts[runs] = column;
+            inRun = true;
+        } else if (!set && inRun) {
+            ends[runs++] = column - 1;
+            inRun = false;
+        }
+    }
+    if (inRun) {
+        ends[runs++] = last;
+    }
+    return runs;
+}
+
+/**
+ * Draws text in the font, each character cell is drawn whole so the pixels around the glyphs are cleared. Text of a
+ * larger size draws every pixel of the font as a square that many pixels across.
+ *
+ * @param framebuffer The framebuffer.
+ * @param x The left of the text.
+ * @param y The top of the text.
+ * @param text The text to be drawn.
+ * @param size How many pixels across each pixel of the font is.
+ */
+void framebufferText(framebufferStruct *framebuffer, const int x, const int y, const char *text, const int size) {
+    for (int left = x; *text != '\0' && left < FRAMEBUFFER_WIDTH; text++, left += FONT_CHARACTER_WIDTH * size) {
+        const uint8_t *glyph = fontGlyph(*text);
+        for (int column = 0; column < FONT_CHARACTER_WIDTH; column++) {
+            const uint8_t bits = column < FONT_GLYPH_WIDTH ? glyph[column] : 0; //The last column is the gap.
+            for (int row = 0; row < FONT_CHARACTER_HEIGHT; row++) {
+                framebufferFillRectangle(framebuffer, left + column * size, y + row * size, size, size,
+                                         bits & (1 << row));
+            }
+        }
+    }
+}
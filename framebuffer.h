@@ -0,0 +1,45 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides a framebuffer, a copy of the 128x64 display kept in memory with one bit for each pixel, and the
+* primitives that draw into it.
+*
+* Each row is 4 32 bit words, bit n of a word is the pixel n columns into the word. Horizontal spans, filled rectangles
+* and inverted areas are done a word at a time with masks for the ends, so a whole row is 4 writes. Lines use
+* Bresenham's algorithm, falling back to a span when they are horizontal or vertical. Everything is clipped to the
+* display so a primitive that goes off the edge is drawn as far as the edge. Text is drawn in the display's font, its
+* glyphs and the gaps between them, so text covers what was under it the way it does on the GUI.
+*/
+#ifndef FRAMEBUFFER_HEADER
+#define FRAMEBUFFER_HEADER
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FRAMEBUFFER_WIDTH 128
+#define FRAMEBUFFER_HEIGHT 64
+#define FRAMEBUFFER_WORD_BITS 32
+#define FRAMEBUFFER_ROW_WORDS (FRAMEBUFFER_WIDTH / FRAMEBUFFER_WORD_BITS)
+
+/**
+ * The pixels of the display, a set bit is a pixel in the foreground colour.
+ */
+typedef struct {
+    uint32_t rows[FRAMEBUFFER_HEIGHT][FRAMEBUFFER_ROW_WORDS];
+} framebufferStruct;
+
+void framebufferClear(framebufferStruct *framebuffer);
+bool framebufferGet(const framebufferStruct *framebuffer, const int x, const int y);
+void framebufferPixel(framebufferStruct *framebuffer, const int x, const int y, const bool set);
+void framebufferSpan(framebufferStruct *framebuffer, const int x, const int x1, const int y, const bool set);
+void framebufferVerticalSpan(framebufferStruct *framebuffer, const int x, const int y, const int y1, const bool set);
+void framebufferLine(framebufferStruct *framebuffer, const int x, const int y, const int x1, const int y1,
+                     const bool set);
+void framebufferRectangle(framebufferStruct *framebuffer, const int x, const int y, const int x1, const int y1,
+                          const bool set); //The outline only.
+void framebufferFillRectangle(framebufferStruct *framebuffer, const int x, const int y, const int w, const int h,
+                              const bool set);
+void framebufferInvert(framebufferStruct *framebuffer, const int x, const int y, const int w, const int h);
+int framebufferRowRuns(const framebufferStruct *framebuffer, const int y, const int x, const int x1, int starts[],
+                       int ends[]); //The runs of set pixels on a row.
+void framebufferText(framebufferStruct *framebuffer, const int x, const int y, const char *text, const int size);
+#endif //FRAMEBUFFER_HEADER
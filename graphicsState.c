@@ -0,0 +1,336 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The graphics state, what the display has been told so commands that change nothing aren't sent.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "fish.h"
+#include "graphicsState.h"
+
+graphicsStateStruct programGraphics = {
+    .palette = {
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .count = PALETTE_FIXED_COLOURS,
+        .rgb = {[PALETTE_WHITE] = 0xFFFFFF, [PALETTE_FEEDER_BLUE] = 0x50CAE0},
+        .names = {[PALETTE_WHITE] = "white", [PALETTE_FEEDER_BLUE] = "50cae0"}
+    },
+    .foreground = GRAPHICS_UNKNOWN,
+    .background = GRAPHICS_UNKNOWN,
+    .clearedTo = GRAPHICS_UNKNOWN,
+    .shownTemplate = NULL,
+    .controller = NULL
+};
+
+/**
+ * Finds a colour in the palette, adding it if it isn't there yet.
+ *
+ * @param graphics The graphics state holding the palette.
+ * @param red The red part of the colour.
+ * @param green The green part of the colour.
+ * @param blue The blue part of the colour.
+ * @return The palette index of the colour, the background colour if the palette is full.
+ */
+int paletteColour(graphicsStateStruct *graphics, const uint8_t red, const uint8_t green, const uint8_t blue) {
+    paletteStruct *palette = &graphics->palette;
+    const uint32_t rgb = (uint32_t) red << 16 | (uint32_t) green << 8 | blue;
+    pthread_mutex_lock(&palette->lock);
+    int index = 0;
+    while (index < palette->count && palette->rgb[index] != rgb) {
+        index++;
+    }
+    if (index == PALETTE_SIZE) {
+        printf("The palette is full, #%06X is shown as the background\n", rgb);
+        index = PALETTE_FEEDER_BLUE;
+    } else if (index == palette->count) {
+        palette->rgb[index] = rgb;
+        snprintf(palette->names[index], PALETTE_NAME_BUFFER, "#%06X", rgb);
+        palette->count++;
+    }
+    pthread_mutex_unlock(&palette->lock);
+    return index;
+}
+
+/**
+ * Forgets what the display has been told, so the next colours and clear are always sent.
+ *
+ * @param graphics The graphics state.
+ */
+void graphicsForget(graphicsStateStruct *graphics) {
+    graphics->foreground = GRAPHICS_UNKNOWN;
+    graphics->background = GRAPHICS_UNKNOWN;
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    graphics->shownTemplate = NULL;
+}
+
+/**
+ * Sets the colours things are drawn in, nothing is sent if they are already set.
+ *
+ * @param graphics The graphics state.
+ * @param foreground The palette index of the colour text and lines are drawn in.
+ * @param background The palette index of the colour behind text and that clearing fills with.
+ */
+void graphicsColour(graphicsStateStruct *graphics, const int foreground, const int background) {
+    if (foreground == graphics->foreground && background == graphics->background) {
+        graphics->commandsElided++;
+        return;
+    }
+    graphics->foreground = foreground;
+    graphics->background = background;
+    displayColour(graphics->palette.names[foreground], graphics->palette.names[background]);
+}
+
+/**
+ * Clears the display to the background colour, nothing is sent if it is already clear in that colour.
+ *
+ * @param graphics The graphics state.
+ */
+void graphicsClear(graphicsStateStruct *graphics) {
+    graphics->shownTemplate = NULL;
+    if (graphics->clearedTo != GRAPHICS_UNKNOWN && graphics->clearedTo == graphics->background) {
+        graphics->commandsElided++;
+        return;
+    }
+    graphics->clearedTo = graphics->background;
+    framebufferClear(&graphics->framebuffer);
+    displayClear();
+}
+
+/**
+ * Clears part of the display to the background colour.
+ *
+ * @param graphics The graphics state.
+ * @param x The left of the area.
+ * @param y The top of the area.
+ * @param w The width of the area.
+ * @param h The height of the area.
+ */
+void graphicsClearArea(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h) {
+    if (graphics->clearedTo != GRAPHICS_UNKNOWN && graphics->clearedTo == graphics->background) {
+        graphics->commandsElided++;
+        return;
+    }
+    framebufferFillRectangle(&graphics->framebuffer, x, y, w, h, false);
+    displayClearArea(x, y, w, h);
+}
+
+/**
+ * Draws text in the current colours, the framebuffer gets the glyphs of the display's font.
+ *
+ * @param graphics The graphics state.
+ * @param x The left of the text.
+ * @param y The top of the text.
+ * @param text The text to be drawn.
+ * @param size 1 or 2.
+ */
+void graphicsText(graphicsStateStruct *graphics, const int x, const int y, const char *text, const int size) {
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    framebufferText(&graphics->framebuffer, x, y, text, size);
+    displayText(x, y, (char *) text, size);
+}
+
+/**
+ * Draws a pixel in the foreground colour.
+ *
+ * @param graphics The graphics state.
+ * @param x The column of the pixel.
+ * @param y The row of the pixel.
+ */
+void graphicsPixel(graphicsStateStruct *graphics, const int x, const int y) {
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    framebufferPixel(&graphics->framebuffer, x, y, true);
+    displayPixel(x, y);
+}
+
+/**
+ * Draws a line in the foreground colour.
+ *
+ * @param graphics The graphics state.
+ * @param x The start column.
+ * @param y The start row.
+ * @param x1 The end column.
+ * @param y1 The end row.
+ */
+void graphicsLine(graphicsStateStruct *graphics, const int x, const int y, const int x1, const int y1) {
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    framebufferLine(&graphics->framebuffer, x, y, x1, y1, true);
+    displayLine(x, y, x1, y1);
+}
+
+/**
+ * Draws a horizontal line in the foreground colour, a single pixel is sent as a pixel.
+ *
+ * @param graphics The graphics state.
+ * @param x The first column.
+ * @param x1 The last column.
+ * @param y The row.
+ */
+void graphicsSpan(graphicsStateStruct *graphics, const int x, const int x1, const int y) {
+    if (x == x1) {
+        graphicsPixel(graphics, x, y);
+    } else {
+        graphicsLine(graphics, x, y, x1, y);
+    }
+}
+
+/**
+ * Draws a vertical line in the foreground colour, a single pixel is sent as a pixel.
+ *
+ * @param graphics The graphics state.
+ * @param x The column.
+ * @param y The first row.
+ * @param y1 The last row.
+ */
+void graphicsVerticalSpan(graphicsStateStruct *graphics, const int x, const int y, const int y1) {
+    if (y == y1) {
+        graphicsPixel(graphics, x, y);
+    } else {
+        graphicsLine(graphics, x, y, x, y1);
+    }
+}
+
+/**
+ * Draws the outline of a rectangle in the foreground colour, a rectangle with no inside is sent as one line.
+ *
+ * @param graphics The graphics state.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param x1 The right of the rectangle.
+ * @param y1 The bottom of the rectangle.
+ */
+void graphicsRectangle(graphicsStateStruct *graphics, const int x, const int y, const int x1, const int y1) {
+    if (y == y1) {
+        graphicsSpan(graphics, x, x1, y);
+    } else if (x == x1) {
+        graphicsVerticalSpan(graphics, x, y, y1);
+    } else {
+        graphicsSpan(graphics, x, x1, y);
+        graphicsSpan(graphics, x, x1, y1);
+        graphicsVerticalSpan(graphics, x, y, y1);
+        graphicsVerticalSpan(graphics, x1, y, y1);
+    }
+}
+
+/**
+ * Fills a rectangle with the foreground colour. The GUI has no fill, so the area is cleared with the background
+ * set to the foreground colour and the colours are put back, a rectangle one pixel across is sent as a line.
+ *
+ * @param graphics The graphics state.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param w The width of the rectangle.
+ * @param h The height of the rectangle.
+ */
+void graphicsFillRectangle(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (h == 1) {
+        graphicsSpan(graphics, x, x + w - 1, y);
+        return;
+    }
+    if (w == 1) {
+        graphicsVerticalSpan(graphics, x, y, y + h - 1);
+        return;
+    }
+    const int foreground = graphics->foreground;
+    const int background = graphics->background;
+    if (foreground == GRAPHICS_UNKNOWN || background == GRAPHICS_UNKNOWN) {
+        //The colours to put back aren't known, so the rectangle is drawn a row at a time in whatever is set.
+        for (int row = y; row < y + h; row++) {
+            graphicsSpan(graphics, x, x + w - 1, row);
+        }
+        return;
+    }
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    framebufferFillRectangle(&graphics->framebuffer, x, y, w, h, true);
+    graphicsColour(graphics, foreground, foreground);
+    displayClearArea(x, y, w, h);
+    graphicsColour(graphics, foreground, background);
+}
+
+/**
+ * Swaps the foreground and background of a rectangle. The GUI can't do this itself, so the area is cleared and drawn
+ * again from the framebuffer one line per run, text in the area is drawn again as the pixels of its glyphs.
+ *
+ * @param graphics The graphics state.
+ * @param x The left of the rectangle.
+ * @param y The top of the rectangle.
+ * @param w The width of the rectangle.
+ * @param h The height of the rectangle.
+ */
+void graphicsInvert(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    graphics->clearedTo = GRAPHICS_UNKNOWN;
+    graphics->shownTemplate = NULL;
+    framebufferInvert(&graphics->framebuffer, x, y, w, h);
+    displayClearArea(x, y, w, h);
+    int starts[FRAMEBUFFER_WIDTH / 2];
+    int ends[FRAMEBUFFER_WIDTH / 2];
+    for (int row = y; row < y + h; row++) {
+        const int runs = framebufferRowRuns(&graphics->framebuffer, row, x, x + w - 1, starts, ends);
+        for (int run = 0; run < runs; run++) {
+            if (starts[run] == ends[run]) {
+                displayPixel(starts[run], row);
+            } else {
+                displayLine(starts[run], row, ends[run], row);
+            }
+        }
+    }
+}
+
+/**
+ * Shows a screen template in the default colours. If the template is already showing nothing is sent, the screen only
+ * has to redraw what changes, otherwise the display is cleared, the template's layer is copied into the framebuffer
+ * and its items are sent.
+ *
+ * @param graphics The graphics state.
+ * @param screenTemplate The template to be shown.
+ * @return True if the template was already showing, false if it has been drawn on a cleared display.
+ */
+bool graphicsShowTemplate(graphicsStateStruct *graphics, const screenTemplateStruct *screenTemplate) {
+    graphicsColour(graphics, PALETTE_WHITE, PALETTE_FEEDER_BLUE);
+    if (graphics->shownTemplate == screenTemplate) {
+        return true;
+    }
+    graphicsClear(graphics);
+    memcpy(&graphics->framebuffer, &screenTemplate->layer, sizeof(framebufferStruct));
+    for (int i = 0; i < screenTemplate->numberOfItems; i++) {
+        const templateItemStruct *item = &screenTemplate->items[i];
+        if (item->kind == TEMPLATE_TEXT) {
+            displayText(item->x, item->y, (char *) item->text, item->size);
+        } else {
+            displayLine(item->x, item->y, item->x1, item->y1);
+        }
+    }
+    graphics->clearedTo = screenTemplate->numberOfItems > 0 ? GRAPHICS_UNKNOWN : graphics->clearedTo;
+    graphics->shownTemplate = screenTemplate;
+    return false;
+}
+
+/**
+ * Turns on the SSD1306 display mode, from now on every frame presented is transferred to the controller.
+ *
+ * @param graphics The graphics state.
+ * @param controller The controller, it is initialised so the first frame transfers every page.
+ */
+void graphicsUseSsd1306(graphicsStateStruct *graphics, ssd1306Struct *controller) {
+    initialiseSsd1306(controller);
+    graphics->controller = controller;
+}
+
+/**
+ * Presents a frame once everything in it has been drawn. In the SSD1306 display mode the frame is loaded into the
+ * controller and its dirty pages are transferred, otherwise nothing needs doing.
+ *
+ * @param graphics The graphics state.
+ */
+void graphicsPresent(graphicsStateStruct *graphics) {
+    if (graphics->controller == NULL) {
+        return;
+    }
+    ssd1306Load(graphics->controller, &graphics->framebuffer);
+    ssd1306Transfer(graphics->controller);
+}
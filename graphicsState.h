@@ -0,0 +1,87 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the graphics state, which keeps track of what the display has been told so commands that wouldn't
+* change anything aren't sent.
+*
+* Colours are kept in a palette and referred to by their index. The text the GUI takes for a colour is made once, when
+* the colour is added, rather than every time the colour is used. The current foreground and background are known so
+* setting the colours that are already set sends nothing, and the display is known to be clear until something is
+* drawn so clearing it again sends nothing.
+*
+* Everything drawn is also drawn into a framebuffer, so what is on the display is known down to the pixel and an area
+* can be drawn again from it. Text is drawn into the framebuffer in the display's font, which is the size of the GUI's
+* font. The richer primitives are sent as the fewest commands the GUI has for them, a
+* filled rectangle is a single clear of the area in the foreground colour rather than a line for every row.
+*
+* In the SSD1306 display mode each frame is also loaded into a model of the real display's controller when it is
+* presented, and only the pages of it that changed are transferred.
+*
+* The screens draw through these functions so the state stays right, anything that draws on the display directly must
+* call graphicsForget afterwards.
+*/
+#ifndef GRAPHICS_STATE_HEADER
+#define GRAPHICS_STATE_HEADER
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "framebuffer.h"
+#include "screenTemplate.h"
+#include "ssd1306.h"
+
+#define PALETTE_SIZE 256
+#define PALETTE_NAME_BUFFER 8 //Enough for #RRGGBB.
+#define GRAPHICS_UNKNOWN (-1) //The display may be any colour.
+
+/**
+ * The colours every screen uses, these are always in the palette.
+ */
+typedef enum {
+    PALETTE_WHITE,
+    PALETTE_FEEDER_BLUE, //The background of every screen.
+    PALETTE_FIXED_COLOURS
+} paletteFixedColour;
+
+/**
+ * The colours that have been used, colours are only ever added so an index stays the same colour.
+ */
+typedef struct {
+    pthread_mutex_t lock; //Colours can be added by any thread.
+    int count;
+    uint32_t rgb[PALETTE_SIZE]; //0xRRGGBB.
+    char names[PALETTE_SIZE][PALETTE_NAME_BUFFER]; //The colour as the GUI takes it.
+} paletteStruct;
+
+/**
+ * What the display has been told.
+ */
+typedef struct {
+    paletteStruct palette;
+    int foreground; //A palette index or GRAPHICS_UNKNOWN.
+    int background; //A palette index or GRAPHICS_UNKNOWN.
+    int clearedTo; //The background the display was cleared to if nothing has been drawn since, else GRAPHICS_UNKNOWN.
+    long long commandsElided; //How many commands weren't sent because they wouldn't change anything.
+    framebufferStruct framebuffer; //What has been drawn.
+    const screenTemplateStruct *shownTemplate; //The template on the display, NULL if it has been cleared since.
+    ssd1306Struct *controller; //The controller frames are transferred to in the SSD1306 display mode, else NULL.
+} graphicsStateStruct;
+
+extern graphicsStateStruct programGraphics; //The state of the display.
+
+int paletteColour(graphicsStateStruct *graphics, const uint8_t red, const uint8_t green, const uint8_t blue);
+void graphicsForget(graphicsStateStruct *graphics); //Something else has drawn on the display.
+void graphicsColour(graphicsStateStruct *graphics, const int foreground, const int background);
+void graphicsClear(graphicsStateStruct *graphics);
+void graphicsClearArea(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h);
+void graphicsText(graphicsStateStruct *graphics, const int x, const int y, const char *text, const int size);
+void graphicsPixel(graphicsStateStruct *graphics, const int x, const int y);
+void graphicsLine(graphicsStateStruct *graphics, const int x, const int y, const int x1, const int y1);
+void graphicsSpan(graphicsStateStruct *graphics, const int x, const int x1, const int y); //A horizontal line.
+void graphicsVerticalSpan(graphicsStateStruct *graphics, const int x, const int y, const int y1);
+void graphicsRectangle(graphicsStateStruct *graphics, const int x, const int y, const int x1, const int y1);
+void graphicsFillRectangle(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h);
+bool graphicsShowTemplate(graphicsStateStruct *graphics, const screenTemplateStruct *screenTemplate);
+void graphicsInvert(graphicsStateStruct *graphics, const int x, const int y, const int w, const int h);
+void graphicsUseSsd1306(graphicsStateStruct *graphics, ssd1306Struct *controller); //The SSD1306 display mode.
+void graphicsPresent(graphicsStateStruct *graphics); //A frame has been drawn.
+#endif //GRAPHICS_STATE_HEADER
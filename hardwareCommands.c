@@ -0,0 +1,21 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The table of every command and message the GUI understands.
+*/
+#include "hardwareCommands.h"
+
+#define HARDWARE_COMMAND_ENTRY(name, kind, parameters, numberOfInts, ints, numberOfTexts, texts, textsAt) \
+    {#name, kind, numberOfInts, numberOfTexts, textsAt},
+
+const hardwareCommandStruct hardwareCommands[COMMAND_OPCODES] = {
+    HARDWARE_COMMANDS(HARDWARE_COMMAND_ENTRY)
+};
+
+/**
+ * @param opcode The command.
+ * @return The name the GUI knows the command by.
+ */
+const char *commandOpcodeName(const commandOpcode opcode) {
+    return hardwareCommands[opcode].name;
+}
@@ -0,0 +1,76 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the table of every command and message the GUI understands, it is the one place a command is
+* defined.
+*
+* The table is an X-macro, each entry is
+*   X(name, kind, parameters, numberOfInts, ints, numberOfTexts, texts, textsAt)
+* name is the name the GUI knows it by and its opcode is COMMAND_<name>. kind says how it is sent. parameters is the
+* typed C parameter list of the command, ints and texts are its arguments split into whole numbers and text, in the
+* form the command recorder records them. The GUI takes the arguments in one list, with the texts inserted before the
+* whole number at index textsAt.
+*
+* The opcodes, the names and the argument layouts are all generated from the table, and so are the typed functions the
+* GUI hardware functions send each command with. Adding a command is adding its entry.
+*/
+#ifndef HARDWARE_COMMANDS_HEADER
+#define HARDWARE_COMMANDS_HEADER
+
+/**
+ * How a command is sent.
+ */
+typedef enum {
+    HARDWARE_COMMAND, //Sent once without waiting.
+    HARDWARE_MESSAGE //Sent and waited for, the GUI gives a result back.
+} hardwareCommandKind;
+
+#define HARDWARE_COMMANDS(X) \
+    X(CLEAR_DISPLAY, HARDWARE_COMMAND, (void), 0, NULL, 0, NULL, 0) \
+    X(MOTOR_STEP, HARDWARE_COMMAND, (void), 0, NULL, 0, NULL, 0) \
+    X(CLEAR_AREA, HARDWARE_COMMAND, (int x, int y, int w, int h), 4, ((long long[]) {x, y, w, h}), 0, NULL, 0) \
+    X(LINE, HARDWARE_COMMAND, (int x, int y, int x1, int y1), 4, ((long long[]) {x, y, x1, y1}), 0, NULL, 0) \
+    X(SET_RTC, HARDWARE_COMMAND, (int sec, int min, int hour, int day, int month, int year), \
+      6, ((long long[]) {sec, min, hour, day, month, year}), 0, NULL, 0) \
+    X(PIXEL, HARDWARE_COMMAND, (int x, int y), 2, ((long long[]) {x, y}), 0, NULL, 0) \
+    X(FOOD, HARDWARE_COMMAND, (int foodLevel), 1, ((long long[]) {foodLevel}), 0, NULL, 0) \
+    X(TEXTXY, HARDWARE_COMMAND, (int x, int y, const char *text, int size), \
+      3, ((long long[]) {x, y, size}), 1, ((const char *[]) {text}), 2) \
+    X(MESSAGE, HARDWARE_COMMAND, (const char *text), 0, NULL, 1, ((const char *[]) {text}), 0) \
+    X(COLOUR, HARDWARE_COMMAND, (const char *fg, const char *bg), 0, NULL, 2, ((const char *[]) {fg, bg}), 0) \
+    X(BUTTON, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_WARM_START, HARDWARE_MESSAGE, (long long offset), 1, ((long long[]) {offset}), 0, NULL, 0) \
+    X(RTC_SECOND, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_MINUTE, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_HOUR, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_DAY, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_MONTH, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_YEAR, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0) \
+    X(RTC_DAY_OF_WEEK, HARDWARE_MESSAGE, (void), 0, NULL, 0, NULL, 0)
+
+#define HARDWARE_COMMAND_OPCODE(name, kind, parameters, numberOfInts, ints, numberOfTexts, texts, textsAt) \
+    COMMAND_##name,
+
+/**
+ * The commands and messages the hardware understands, in table order.
+ */
+typedef enum {
+    HARDWARE_COMMANDS(HARDWARE_COMMAND_OPCODE)
+    COMMAND_OPCODES
+} commandOpcode;
+
+/**
+ * What the table says about a command, without its parameter types.
+ */
+typedef struct {
+    const char *name;
+    hardwareCommandKind kind;
+    int numberOfInts;
+    int numberOfTexts;
+    int textsAt; //Where the texts go in the arguments the GUI takes.
+} hardwareCommandStruct;
+
+extern const hardwareCommandStruct hardwareCommands[COMMAND_OPCODES]; //Indexed by opcode.
+
+const char *commandOpcodeName(const commandOpcode opcode); //The name the GUI knows a command by.
+#endif //HARDWARE_COMMANDS_HEADER
@@ -0,0 +1,140 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The hardware queue, requests from any thread to the bridge thread that talks to the GUI.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hardwareQueue.h"
+
+hardwareQueueStruct programHardwareQueue = {
+    .lock = PTHREAD_MUTEX_INITIALIZER, .requestAdded = PTHREAD_COND_INITIALIZER,
+    .spaceFreed = PTHREAD_COND_INITIALIZER, .requestDone = PTHREAD_COND_INITIALIZER
+};
+
+/**
+ * Fills in a request, in the same form the command recorder takes a record.
+ *
+ * @param request The request to be filled in.
+ * @param opcode The command.
+ * @param numberOfInts How many whole number arguments the command has.
+ * @param ints The whole number arguments.
+ * @param numberOfTexts How many text arguments the command has.
+ * @param texts The text arguments, these are copied until releaseHardwareRequest.
+ */
+void initialiseHardwareRequest(hardwareRequestStruct *request, const int opcode, const int numberOfInts,
+                               const long long ints[], const int numberOfTexts, const char *const texts[]) {
+    request->opcode = opcode;
+    request->numberOfInts = numberOfInts;
+    for (int i = 0; i < numberOfInts; i++) {
+        request->ints[i] = ints[i];
+    }
+    request->numberOfTexts = numberOfTexts;
+    for (int i = 0; i < numberOfTexts; i++) {
+        request->texts[i] = strndup(texts[i], COMMAND_TEXT_BUFFER - 1);
+    }
+    request->future = NULL;
+}
+
+/**
+ * Frees the texts copied into a request, once it has been sent.
+ *
+ * @param request The request.
+ */
+void releaseHardwareRequest(hardwareRequestStruct *request) {
+    for (int i = 0; i < request->numberOfTexts; i++) {
+        free(request->texts[i]);
+        request->texts[i] = NULL;
+    }
+    request->numberOfTexts = 0;
+}
+
+/**
+ * Adds a request to the back of the queue, waiting for space if the queue is full.
+ * The queue lock must be held.
+ *
+ * @param queue The queue.
+ * @param request The request to be added.
+ */
+static void addRequest(hardwareQueueStruct *queue, const hardwareRequestStruct *request) {
+    while (queue->count == HARDWARE_QUEUE_SIZE) {
+        pthread_cond_wait(&queue->spaceFreed, &queue->lock);
+    }
+    queue->requests[(queue->head + queue->count) % HARDWARE_QUEUE_SIZE] = *request;
+    queue->count++;
+    pthread_cond_signal(&queue->requestAdded);
+}
+
+/**
+ * Sends a command, this returns as soon as the command is queued.
+ *
+ * @param queue The queue.
+ * @param request The command.
+ */
+void hardwareQueueSend(hardwareQueueStruct *queue, const hardwareRequestStruct *request) {
+    pthread_mutex_lock(&queue->lock);
+    addRequest(queue, request);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+ * Sends a message and waits for the bridge to complete its future. Everything sent before the message, from the same
+ * thread, has been sent to the GUI by the time it returns.
+ *
+ * @param queue The queue.
+ * @param request The message.
+ * @param future Completed with the result of the message.
+ */
+void hardwareQueueCall(hardwareQueueStruct *queue, hardwareRequestStruct *request, hardwareFutureStruct *future) {
+    future->done = false;
+    request->future = future;
+    pthread_mutex_lock(&queue->lock);
+    addRequest(queue, request);
+    while (!future->done) {
+        pthread_cond_wait(&queue->requestDone, &queue->lock);
+    }
+    pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+ * Takes every request waiting in the queue, up to a batch, waiting for one if the queue is empty.
+ * Only the bridge thread takes requests.
+ *
+ * @param queue The queue.
+ * @param batch Set to the requests taken, in the order they were sent. Must hold HARDWARE_QUEUE_BATCH requests.
+ * @return How many requests were taken.
+ */
+int hardwareQueueTake(hardwareQueueStruct *queue, hardwareRequestStruct batch[]) {
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0) {
+        pthread_cond_wait(&queue->requestAdded, &queue->lock);
+    }
+    const bool wasFull = queue->count == HARDWARE_QUEUE_SIZE;
+    int taken = 0;
+    while (queue->count > 0 && taken < HARDWARE_QUEUE_BATCH) {
+        batch[taken++] = queue->requests[queue->head];
+        queue->head = (queue->head + 1) % HARDWARE_QUEUE_SIZE;
+        queue->count--;
+    }
+    if (wasFull) {
+        pthread_cond_broadcast(&queue->spaceFreed);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+
+/**
+ * Completes the future of a message, waking the thread that sent it.
+ *
+ * @param queue The queue.
+ * @param future The future of the message.
+ * @param result The result the GUI gave.
+ */
+void hardwareQueueComplete(hardwareQueueStruct *queue, hardwareFutureStruct *future, const char *result) {
+    pthread_mutex_lock(&queue->lock);
+    snprintf(future->result, COMMAND_TEXT_BUFFER, "%s", result);
+    future->done = true;
+    pthread_cond_broadcast(&queue->requestDone);
+    pthread_mutex_unlock(&queue->lock);
+}
@@ -0,0 +1,68 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the hardware queue, which carries hardware commands and messages from any thread to the one thread
+* that is allowed to talk to the GUI.
+*
+* A JNI environment is only valid on the thread it was got on, so only the bridge thread that owns it can call into the
+* GUI. Any number of threads add requests to the queue and the bridge takes them off in order. A command is not waited
+* for, the thread that sent it carries on while the bridge sends it. A message is sent with a future that the bridge
+* completes with the result, the thread that sent it waits for the future.
+*
+* The bridge takes every request that is waiting in one go, so commands sent back to back only take the lock once.
+*/
+#ifndef HARDWARE_QUEUE_HEADER
+#define HARDWARE_QUEUE_HEADER
+#include <pthread.h>
+#include <stdbool.h>
+#include "commandRecorder.h"
+
+#define HARDWARE_QUEUE_SIZE 256
+#define HARDWARE_QUEUE_BATCH 32 //The most requests the bridge takes at once.
+#define HARDWARE_FLUSH COMMAND_OPCODES //Not a hardware command, completed once everything before it has been sent.
+#define HARDWARE_EXIT (COMMAND_OPCODES + 1) //Not a hardware command, asks the bridge to close the GUI.
+
+/**
+ * The result of a message, completed by the bridge.
+ */
+typedef struct {
+    bool done;
+    char result[COMMAND_TEXT_BUFFER];
+} hardwareFutureStruct;
+
+/**
+ * A command or message, laid out like a record of the command recorder. The texts are copied out of the request so the
+ * sender's strings don't need to last, and so the commands without text, most of them, stay small in the queue.
+ */
+typedef struct {
+    int opcode; //A commandOpcode, HARDWARE_FLUSH or HARDWARE_EXIT.
+    int numberOfInts;
+    long long ints[COMMAND_MAX_INTS];
+    int numberOfTexts;
+    char *texts[COMMAND_MAX_TEXTS]; //Copies of the sender's texts, freed by releaseHardwareRequest once it is sent.
+    hardwareFutureStruct *future; //NULL for a command.
+} hardwareRequestStruct;
+
+/**
+ * The queue, a ring of requests shared by every sender and the bridge.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t requestAdded; //Signalled when a request is added.
+    pthread_cond_t spaceFreed; //Broadcast when the bridge takes requests off a full queue.
+    pthread_cond_t requestDone; //Broadcast when a future is completed.
+    hardwareRequestStruct requests[HARDWARE_QUEUE_SIZE];
+    int head; //The next request the bridge takes.
+    int count;
+} hardwareQueueStruct;
+
+extern hardwareQueueStruct programHardwareQueue; //The queue to the GUI.
+
+void initialiseHardwareRequest(hardwareRequestStruct *request, const int opcode, const int numberOfInts,
+                               const long long ints[], const int numberOfTexts, const char *const texts[]);
+void releaseHardwareRequest(hardwareRequestStruct *request); //Frees the copied texts, once the request is sent.
+void hardwareQueueSend(hardwareQueueStruct *queue, const hardwareRequestStruct *request); //Doesn't wait for it.
+void hardwareQueueCall(hardwareQueueStruct *queue, hardwareRequestStruct *request, hardwareFutureStruct *future);
+int hardwareQueueTake(hardwareQueueStruct *queue, hardwareRequestStruct batch[]); //Used by the bridge only.
+void hardwareQueueComplete(hardwareQueueStruct *queue, hardwareFutureStruct *future, const char *result);
+#endif //HARDWARE_QUEUE_HEADER
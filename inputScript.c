@@ -0,0 +1,104 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* Input scripts that press the button in place of the user.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inputScript.h"
+#include "timerWheel.h"
+
+inputScriptStruct programInput;
+
+/**
+ * Reads a script file, each line is checked and the first bad line stops the script being loaded.
+ *
+ * @param script The script to load into.
+ * @param filename The name of the script file.
+ * @return If the whole script was read.
+ */
+bool loadInputScript(inputScriptStruct *script, const char *filename) {
+    script->loaded = false;
+    script->numberOfEvents = 0;
+    script->nextEvent = 0;
+    script->startMs = -1;
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        printf("Input script: %s can't be opened\n", filename);
+        return false;
+    }
+    char line[128];
+    int lineNumber = 0;
+    long previousMs = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        long atMs;
+        char event[24];
+        const int fields = sscanf(line, "%ld %23s", &atMs, event);
+        if (line[0] == '#' || fields == EOF) {
+            continue; //A comment or a blank line.
+        }
+        if (fields != 2 || atMs < previousMs || script->numberOfEvents == INPUT_SCRIPT_MAX_EVENTS) {
+            printf("Input script: %s line %d is invalid or out of order\n", filename, lineNumber);
+            fclose(file);
+            return false;
+        }
+        inputEventStruct *next = &script->events[script->numberOfEvents];
+        next->atMs = atMs;
+        if (strcmp(event, "SHORT_PRESS") == 0) {
+            next->type = INPUT_SHORT_PRESS;
+        } else if (strcmp(event, "LONG_PRESS") == 0) {
+            next->type = INPUT_LONG_PRESS;
+        } else if (strcmp(event, "IDLE") == 0) {
+            next->type = INPUT_IDLE;
+        } else {
+            printf("Input script: %s line %d has an unknown event '%s'\n", filename, lineNumber, event);
+            fclose(file);
+            return false;
+        }
+        previousMs = atMs;
+        script->numberOfEvents++;
+    }
+    fclose(file);
+    script->loaded = true;
+    printf("Input script: %d events loaded from %s\n", script->numberOfEvents, filename);
+    return true;
+}
+
+/**
+ * @param script The script.
+ * @return If a script has been loaded, the button is then read from the script.
+ */
+bool inputScriptLoaded(const inputScriptStruct *script) {
+    return script->loaded;
+}
+
+/**
+ * Reads the button from the script, the next event is given if its time has come.
+ * The program is stopped if the script finished a while ago and the program hasn't quit.
+ *
+ * @param script The script.
+ * @return "SHORT_PRESS", "LONG_PRESS" or "NO_PRESS", the caller must free it.
+ */
+char *inputScriptButtonState(inputScriptStruct *script) {
+    const long long nowMs = monotonicMs();
+    if (script->startMs < 0) {
+        script->startMs = nowMs; //The times in the script start from here.
+    }
+    const long elapsedMs = (long) (nowMs - script->startMs);
+    inputEventType type = INPUT_IDLE;
+    if (script->nextEvent < script->numberOfEvents) {
+        if (script->events[script->nextEvent].atMs <= elapsedMs) {
+            type = script->events[script->nextEvent].type;
+            script->nextEvent++;
+        }
+    } else if (elapsedMs > (script->numberOfEvents > 0 ? script->events[script->numberOfEvents - 1].atMs : 0) +
+               INPUT_SCRIPT_TIMEOUT_MS) {
+        printf("Input script: finished %ldms ago without the program quitting\n", INPUT_SCRIPT_TIMEOUT_MS);
+        exit(EXIT_FAILURE);
+    }
+    char *result = malloc(12);
+    strcpy(result, type == INPUT_SHORT_PRESS ? "SHORT_PRESS" : type == INPUT_LONG_PRESS ? "LONG_PRESS" : "NO_PRESS");
+    return result;
+}
@@ -0,0 +1,55 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides input scripts, a way to press the button from a file instead of by hand.
+*
+* Each line of a script is a time in milliseconds and an event, for example '1500 SHORT_PRESS'. The times are counted
+* from when the program first reads the button so the startup doesn't need to be allowed for. The events are
+* SHORT_PRESS, LONG_PRESS and IDLE, an IDLE does nothing but keeps the script running until its time (for example to
+* wait for the blank screen). Blank lines and lines starting with '#' are ignored.
+*
+* Each event is given to the program the first time the button is read after the events time, one event per read.
+* A script should end by quitting the program, if the program is still reading the button INPUT_SCRIPT_TIMEOUT_MS after
+* the last event the script has gone wrong and the program is stopped.
+*/
+#ifndef INPUT_SCRIPT_HEADER
+#define INPUT_SCRIPT_HEADER
+#include <stdbool.h>
+
+#define INPUT_SCRIPT_MAX_EVENTS 1024
+#define INPUT_SCRIPT_TIMEOUT_MS 5000L
+
+/**
+ * The kinds of event a script can hold.
+ */
+typedef enum {
+    INPUT_IDLE,
+    INPUT_SHORT_PRESS,
+    INPUT_LONG_PRESS
+} inputEventType;
+
+/**
+ * One line of a script.
+ */
+typedef struct {
+    long atMs; //When the event happens, from the first read of the button.
+    inputEventType type;
+} inputEventStruct;
+
+/**
+ * A loaded script and how far through it the program is.
+ */
+typedef struct {
+    inputEventStruct events[INPUT_SCRIPT_MAX_EVENTS];
+    int numberOfEvents;
+    int nextEvent; //The next event to be given to the program.
+    long long startMs; //When the button was first read, -1 before then.
+    bool loaded;
+} inputScriptStruct;
+
+extern inputScriptStruct programInput; //The script pressing the button, if one was given.
+
+bool loadInputScript(inputScriptStruct *script, const char *filename);
+bool inputScriptLoaded(const inputScriptStruct *script);
+char *inputScriptButtonState(inputScriptStruct *script); //Like buttonState, the caller must free the result.
+#endif //INPUT_SCRIPT_HEADER
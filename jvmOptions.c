@@ -0,0 +1,79 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The options the JVM that runs the GUI is started with.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jvmOptions.h"
+
+jvmOptionsStruct programJvmOptions;
+
+/**
+ * Starts a set of options with only the option that makes the GUI module the main module.
+ *
+ * @param jvmOptions The options to be initialised.
+ */
+void initialiseJvmOptions(jvmOptionsStruct *jvmOptions) {
+    jvmOptions->count = 0;
+    jvmOptions->bufferUsed = 0;
+    jvmOptionsAdd(jvmOptions, "-Djdk.module.main=nns.fishfeedergui");
+}
+
+/**
+ * Adds an option, the option is copied so it doesn't need to last.
+ *
+ * @param jvmOptions The options to be added to.
+ * @param option The option as it would be given to java on the command line.
+ * @return If the option was added, false if there is no room for it.
+ */
+bool jvmOptionsAdd(jvmOptionsStruct *jvmOptions, const char *option) {
+    const int length = (int) strlen(option) + 1;
+    if (jvmOptions->count == JVM_MAX_OPTIONS || jvmOptions->bufferUsed + length > JVM_OPTIONS_BUFFER) {
+        printf("Too many JVM options, %s is ignored\n", option);
+        return false;
+    }
+    char *copy = jvmOptions->buffer + jvmOptions->bufferUsed;
+    memcpy(copy, option, (size_t) length);
+    jvmOptions->bufferUsed += length;
+    jvmOptions->options[jvmOptions->count++] = copy;
+    return true;
+}
+
+/**
+ * Starts the JVM from a class data sharing archive. If the archive doesn't exist or doesn't match the JVM the JVM
+ * starts as normal and records the archive when it exits, so the first run is a training run for the ones after it.
+ *
+ * @param jvmOptions The options to be added to.
+ * @param archiveFilename The archive to be used.
+ * @return If the options were added.
+ */
+bool jvmOptionsUseSharedArchive(jvmOptionsStruct *jvmOptions, const char *archiveFilename) {
+    char option[JVM_OPTIONS_BUFFER];
+    snprintf(option, sizeof(option), "-XX:SharedArchiveFile=%s", archiveFilename);
+    return jvmOptionsAdd(jvmOptions, "-XX:+AutoCreateSharedArchive") && jvmOptionsAdd(jvmOptions, option);
+}
+
+/**
+ * Adds every option in the FISH_JVM_OPTIONS environment variable, they come after the other options so they can
+ * override them.
+ *
+ * @param jvmOptions The options to be added to.
+ * @return If every option was added, true if the variable isn't set.
+ */
+bool jvmOptionsAddFromEnvironment(jvmOptionsStruct *jvmOptions) {
+    const char *variable = getenv(JVM_OPTIONS_VARIABLE);
+    if (variable == NULL) {
+        return true;
+    }
+    char options[JVM_OPTIONS_BUFFER];
+    snprintf(options, sizeof(options), "%s", variable);
+    bool allAdded = true;
+    char *savePointer;
+    for (char *option = strtok_r(options, " \t", &savePointer); option != NULL;
+         option = strtok_r(NULL, " \t", &savePointer)) {
+        allAdded = jvmOptionsAdd(jvmOptions, option) && allAdded;
+    }
+    return allAdded;
+}
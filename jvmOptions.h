@@ -0,0 +1,37 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the options the JVM that runs the GUI is started with.
+*
+* The JVM always needs the GUI module as its main module. Any other options, such as the heap size or tiered compilation
+* settings, can be given in the FISH_JVM_OPTIONS environment variable separated by spaces.
+*
+* Starting the JVM is the slowest part of bringing the program up, most of it spent loading and verifying the JavaFX
+* classes. A class data sharing archive holds those classes already loaded so they can be mapped straight in, when one
+* is used and doesn't exist yet (or was made by a different JVM) it is recorded when the JVM exits.
+*/
+#ifndef JVM_OPTIONS_HEADER
+#define JVM_OPTIONS_HEADER
+#include <stdbool.h>
+
+#define JVM_MAX_OPTIONS 32
+#define JVM_OPTIONS_BUFFER 2048
+#define JVM_OPTIONS_VARIABLE "FISH_JVM_OPTIONS"
+
+/**
+ * The options, each points into the buffer.
+ */
+typedef struct {
+    int count;
+    char *options[JVM_MAX_OPTIONS];
+    char buffer[JVM_OPTIONS_BUFFER];
+    int bufferUsed;
+} jvmOptionsStruct;
+
+extern jvmOptionsStruct programJvmOptions; //The options of the JVM that runs the GUI.
+
+void initialiseJvmOptions(jvmOptionsStruct *jvmOptions); //Starts the options with the GUI module.
+bool jvmOptionsAdd(jvmOptionsStruct *jvmOptions, const char *option);
+bool jvmOptionsUseSharedArchive(jvmOptionsStruct *jvmOptions, const char *archiveFilename); //Creates it if needed.
+bool jvmOptionsAddFromEnvironment(jvmOptionsStruct *jvmOptions); //Adds the options in FISH_JVM_OPTIONS.
+#endif //JVM_OPTIONS_HEADER
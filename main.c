@@ -4,41 +4,196 @@
 * The main entry point function's:
 * main() , the program entry point and userProcessing(), the entry point for the fish feeder main logic.
 */
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "commandRecorder.h"
 #include "displayScreens.h"
+#include "eepromImage.h"
+#include "eepromJournal.h"
+#include "feedHistory.h"
+#include "feedQueue.h"
 #include "fish.h"
+#include "graphicsState.h"
+#include "inputScript.h"
+#include "jvmOptions.h"
 #include "operatingMode.h"
+#include "menuEngine.h"
 #include "menus.h"
-#include "programShutdown.h"
+#include "motorController.h"
+#include "multiFeeder.h"
 #include "programStartup.h"
+#include "startupPipeline.h"
+#include "timerWheel.h"
+#define EEPROM_FILENAME "fakeEEPROM.bin"
+#define FEED_HISTORY_FILENAME "feedHistory.bin"
 
+static const char *replayFilename = NULL; //The recording to replay instead of running the program, if one was given.
+static bool replayAtRecordedPace = true;
+static bool printReports = false; //If the reports of how the program ran are printed when it exits.
+static const char *expectedFilename = NULL; //The state the program should have saved when it exits, if one was given.
+
+/**
+ * Reads back what the program saved, the same way it is read when the program starts, and checks it against the
+ * expected state. The expected state is in the form of the old text save file, its clock value isn't checked.
+ *
+ * @return If the saved state is the expected state, false if either can't be read.
+ */
+static bool savedStateIsExpected() {
+    operatingModeStruct expected;
+    operatingModeStruct saved;
+    long long warmStartValue;
+    if (!readEEPROMFile(expectedFilename, &expected, &warmStartValue)) {
+        printf("Expected state: %s can't be read\n", expectedFilename);
+        return false;
+    }
+    readEEPROMImage(EEPROM_FILENAME, &saved, &warmStartValue);
+    bool matches = saved.mode == expected.mode && saved.nextFeed == expected.nextFeed &&
+                   saved.numberOfFeedsInADay == expected.numberOfFeedsInADay &&
+                   saved.autoFeedsDone == expected.autoFeedsDone;
+    for (int i = 0; matches && i < expected.numberOfFeedsInADay; i++) {
+        matches = saved.feedTimes[i].hour == expected.feedTimes[i].hour &&
+                  saved.feedTimes[i].minute == expected.feedTimes[i].minute &&
+                  saved.feedTimes[i].rotations == expected.feedTimes[i].rotations;
+    }
+    printf("Expected state: mode %d, next feed %d, %d feeds, %d auto feeds done %s\n", saved.mode, saved.nextFeed,
+           saved.numberOfFeedsInADay, saved.autoFeedsDone, matches ? "as expected" : "is not what was expected");
+    return matches;
+}
 
 /**
  * This function is the entry point for the fish feeder C program main logic.
  * It is called by jniSetup() from main, once the GUI thread has been initialised.
  *
- * The splash screen is displayed, it attempts to read the 'fakeEEPROM.txt', then the main screen is displayed.
+ * The splash screen is displayed until the 'fakeEEPROM.bin' image, which main started reading, has been read. Then the
+ * main screen is displayed.
  *
- * When the main screen is exited the current operating modes information is saved to 'fakeEEPROM.txt'.
+ * When the main screen is exited the current operating modes information is saved to 'fakeEEPROM.bin'.
+ * If a command recording is to be replayed that is done instead.
  */
 void userProcessing() {
-    displaySplashScreen();
+    if (replayFilename != NULL) {
+        replayCommandRecording(replayFilename, replayAtRecordedPace);
+        closeCommandRecorder(&programRecorder);
+        return;
+    }
+    initialiseTimerWheel(&programTimers); //Every timer in the program is driven from this wheel.
+    initialiseMotorController(showFeedProgress); //The motor turns in the background showing its progress.
+    initialiseFeedQueue(); //Every feed goes through the feed queue.
+    taskStruct splashTask;
+    startSplashScreen(&splashTask); //Shown until the rest of the startup is done.
+    graphicsPresent(&programGraphics);
+    displayFlush();
+    startupPhaseFinished(&programStartup, STARTUP_FIRST_FRAME);
     //Creates an instance of operatingModeStruct which will be used throughout the code.
     operatingModeStruct operatingMode;
-    loadFromEEPROM("fakeEEPROM.txt", &operatingMode); //Reads the save file.
+    finishStartup(&programStartup, &operatingMode); //Takes what was read from the save file and the feed history.
+    stopSplashScreen(&splashTask);
+    openJournal(&programJournal, EEPROM_FILENAME, &operatingMode); //Every change is journaled from now on.
     mainScreen(&operatingMode); //Enters the fish feeder main screen.
+    feedQueueWaitUntilIdle(); //Lets any feed in progress or waiting finish.
 
-    saveToEEPROM("fakeEEPROM.txt", &operatingMode); //Saves operating mode information.
+    closeJournal(&programJournal); //Saves operating mode information.
+    const bool stateIsExpected = expectedFilename == NULL || savedStateIsExpected();
+    if (printReports) {
+        eepromWearReport(&programEEPROM); //Shows how hard the program is on the EEPROM.
+        if (programGraphics.controller != NULL) {
+            ssd1306Report(programGraphics.controller); //Shows what the display's bus would have carried.
+        }
+        feedHistoryPrintDays(&programHistory, 7); //Shows the feeds of the last week.
+    }
+    closeEEPROMImage(&programEEPROM);
+    closeFeedHistory(&programHistory);
+    closeCommandRecorder(&programRecorder); //Finishes the recording, if there is one.
+    if (!stateIsExpected) {
+        exit(EXIT_FAILURE);
+    }
 }
 
 
 /**
  * main entry point for the Fish Feeder Emulator program
  *
+ * Running the program with '--feeders <number>' hosts that many headless feeders instead of starting the GUI.
+ * Running the program with '--script <file>' presses the button from an input script instead of the user.
+ * Running the program with '--record <file>' records every hardware command to the file.
+ * Running the program with '--cds <file>' starts the JVM from a class data sharing archive, recording it if needed.
+ * Running the program with '--frame-rate <number>' changes how many times a second the screen can be redrawn.
+ * Running the program with '--display ssd1306' also transfers every frame to a model of the display's controller.
+ * Running the program with '--reports' prints how the motor, the EEPROM, the menus and the display did.
+ * Running the program with '--expect <file>' fails if the state saved when it exits isn't the one in the file.
+ * Running the program with '--replay <file>' sends a recording to the hardware at its recorded pace instead of running
+ * the program, '--replay-fast <file>' sends it as fast as possible.
+ * Apart from '--feeders' the options can be combined.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return "EXIT_SUCCESS"
  */
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc == 3 && strcmp(argv[1], "--feeders") == 0) {
+        return runMultiFeeder(atoi(argv[2])); //Multi-feeder mode, the JVM is not started.
+    }
+    initialiseJvmOptions(&programJvmOptions);
+    //Apart from '--reports' every option is followed by a file name or a number.
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reports") == 0) {
+            printReports = true;
+            motorPrintTiming = true;
+            menuPrintReport = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            printf("%s needs a value\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        const char *option = argv[i];
+        const char *value = argv[++i];
+        if (strcmp(option, "--script") == 0) {
+            if (!loadInputScript(&programInput, value)) {
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(option, "--record") == 0) {
+            if (!openCommandRecorder(&programRecorder, value)) {
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(option, "--cds") == 0) {
+            if (!jvmOptionsUseSharedArchive(&programJvmOptions, value)) {
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(option, "--frame-rate") == 0) {
+            menuFrameRate = atoi(value);
+            if (menuFrameRate <= 0) {
+                printf("The frame rate must be at least 1 frame a second\n");
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(option, "--display") == 0) {
+            if (strcmp(value, "ssd1306") == 0) {
+                graphicsUseSsd1306(&programGraphics, &programSsd1306);
+            } else if (strcmp(value, "gui") != 0) {
+                printf("Unknown display mode %s, it can be gui or ssd1306\n", value);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(option, "--expect") == 0) {
+            expectedFilename = value;
+        } else if (strcmp(option, "--replay") == 0 || strcmp(option, "--replay-fast") == 0) {
+            replayFilename = value;
+            replayAtRecordedPace = strcmp(option, "--replay") == 0;
+        } else {
+            printf("Unknown option %s\n", option);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!jvmOptionsAddFromEnvironment(&programJvmOptions)) {
+        return EXIT_FAILURE;
+    }
+    if (replayFilename == NULL) {
+        //Reading the save files and decoding the splash screen happen while the JVM starts.
+        startStartup(&programStartup, EEPROM_FILENAME, FEED_HISTORY_FILENAME);
+    }
+
     // turn on all console logging for the Java and fish feeder JNI C code. Shouldn't need this
     //logAddInfo(GENERAL | METHOD_ENTRY | JNI_MESSAGES | JFX_MESSAGES | THREAD_NAME | THREAD_ID | STACK_INFO);
     //logAddInfo( GENERAL | JFX_MESSAGES | THREAD_NAME | THREAD_ID );
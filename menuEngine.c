@@ -0,0 +1,355 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The menu engine, a stack of screen descriptors run by a single event loop.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "displayScreens.h"
+#include "fish.h"
+#include "graphicsState.h"
+#include "menuEngine.h"
+#include "menusFunctions.h"
+
+int menuFrameRate = MENU_FRAME_RATE;
+bool menuPrintReport = false;
+
+static void presentFrame(menuEngineStruct *engine);
+static void scheduleFrame(menuEngineStruct *engine);
+
+/**
+ * Called by the timer wheel once a frame interval has passed since the last frame, the frame that was waiting is drawn
+ * with whatever the latest state is.
+ *
+ * @param timer The frame timer.
+ * @param context The engine.
+ */
+static void frameDue(timerStruct *timer, void *context) {
+    (void) timer;
+    presentFrame(context);
+}
+
+/**
+ * Called by the timer wheel when the user has been inactive for long enough, the inactivity screen is shown on top of
+ * whatever screen was showing.
+ *
+ * @param timer The inactivity timer.
+ * @param context The engine.
+ */
+static void inactivityDue(timerStruct *timer, void *context) {
+    (void) timer;
+    menuEngineStruct *engine = context;
+    if (engine->depth > 0) {
+        menuPush(engine, engine->inactivityScreen, 0);
+    }
+}
+
+/**
+ * Called by the timer wheel every half second to check if it's time to feed the fish, then re-arms itself.
+ *
+ * @param timer The feed check timer.
+ * @param context The engine.
+ */
+static void feedCheckDue(timerStruct *timer, void *context) {
+    menuEngineStruct *engine = context;
+    checkIfItsTimeToFeedFish(engine->operatingMode, &engine->previousMinute);
+    timerWheelAdd(&programTimers, timer, MENU_FEED_CHECK_MS);
+}
+
+/**
+ * Restarts the count of how long the user has been inactive, unless the inactivity screen is already showing.
+ *
+ * @param engine The engine.
+ */
+static void resetInactivity(menuEngineStruct *engine) {
+    if (engine->depth > 0 && engine->stack[engine->depth - 1].screen == engine->inactivityScreen) {
+        timerWheelCancel(&programTimers, &engine->inactivityTimer);
+    } else {
+        timerWheelAdd(&programTimers, &engine->inactivityTimer, MENU_INACTIVITY_MS);
+    }
+}
+
+/**
+ * Sets up an engine with nothing on its stack.
+ *
+ * @param engine The engine to be initialised.
+ * @param operatingMode The operating mode the screens change.
+ * @param inactivityScreen The screen shown when the user has been inactive.
+ */
+void initialiseMenuEngine(menuEngineStruct *engine, operatingModeStruct *operatingMode,
+                          const menuScreenStruct *inactivityScreen) {
+    engine->depth = 0;
+    engine->operatingMode = operatingMode;
+    engine->inactivityScreen = inactivityScreen;
+    engine->dirty = false;
+    engine->updateDirty = false;
+    engine->feedProgress = 0;
+    engine->progressDirty = false;
+    engine->previousMinute = -1;
+    engine->numberOfTransitions = 0;
+    engine->frameIntervalUs = 1000000LL / (menuFrameRate > 0 ? menuFrameRate : MENU_FRAME_RATE);
+    engine->lastFrameUs = monotonicUs() - engine->frameIntervalUs; //The first frame doesn't wait.
+    engine->framesDrawn = 0;
+    engine->framesCoalesced = 0;
+    engine->pressedScreen = NULL;
+    initialiseTimer(&engine->inactivityTimer, inactivityDue, engine);
+    initialiseTimer(&engine->feedCheckTimer, feedCheckDue, engine);
+    initialiseTimer(&engine->frameTimer, frameDue, engine);
+}
+
+/**
+ * Enters a screen, it is drawn on the next pass of the loop.
+ *
+ * @param engine The engine.
+ * @param screen The descriptor of the screen.
+ * @param position The feed in the schedule the screen works on, if it works on one.
+ * @return The frame of the new screen.
+ */
+menuFrameStruct *menuPush(menuEngineStruct *engine, const menuScreenStruct *screen, const int position) {
+    if (engine->depth == MENU_STACK_DEPTH) {
+        printf("Menu stack full, %s not shown\n", screen->name);
+        return &engine->stack[engine->depth - 1];
+    }
+    menuFrameStruct *frame = &engine->stack[engine->depth];
+    memset(frame, 0, sizeof(menuFrameStruct));
+    frame->screen = screen;
+    frame->currentSelection = screen->firstOption;
+    frame->position = position;
+    frame->previousSecond = -1;
+    engine->depth++;
+    if (screen->onEnter != NULL) {
+        screen->onEnter(engine, frame);
+    }
+    engine->dirty = true;
+    resetInactivity(engine);
+    return frame;
+}
+
+/**
+ * Leaves the top screen, the screen below is told and then redrawn. Leaving the inactivity screen isn't passed on since
+ * the screen below never asked for it.
+ *
+ * @param engine The engine.
+ */
+void menuPop(menuEngineStruct *engine) {
+    if (engine->depth == 0) {
+        return;
+    }
+    engine->depth--;
+    const bool wasInactive = engine->stack[engine->depth].screen == engine->inactivityScreen;
+    engine->dirty = true;
+    if (engine->depth == 0) {
+        return;
+    }
+    resetInactivity(engine);
+    menuFrameStruct *frame = &engine->stack[engine->depth - 1];
+    if (!wasInactive && frame->screen->onResume != NULL) {
+        frame->screen->onResume(engine, frame);
+    }
+}
+
+/**
+ * Marks the top screen as needing to be redrawn, it is drawn in the next frame.
+ *
+ * @param engine The engine.
+ */
+void menuRedraw(menuEngineStruct *engine) {
+    engine->dirty = true;
+}
+
+/**
+ * Marks the parts of the top screen that change on their own as needing to be redrawn, they are drawn in the next frame
+ * without redrawing the rest of the screen.
+ *
+ * @param engine The engine.
+ */
+void menuRedrawUpdate(menuEngineStruct *engine) {
+    engine->updateDirty = true;
+}
+
+/**
+ * Sets how far through a feed the motor is, the progress bar is drawn in the next frame.
+ *
+ * @param engine The engine.
+ * @param percentDone How much of the feed has been done.
+ */
+void menuFeedProgress(menuEngineStruct *engine, const int percentDone) {
+    engine->feedProgress = percentDone;
+    engine->progressDirty = true;
+    scheduleFrame(engine); //The motor runs among the timers, so the loop may not pass before the next frame is due.
+}
+
+/**
+ * Gives a button press to the top screen. A short press on a screen without its own handler moves the selection on to
+ * the next option, going back to the first option after the last.
+ *
+ * @param engine The engine.
+ * @param isLong If the press was a long press.
+ */
+static void dispatchPress(menuEngineStruct *engine, const bool isLong) {
+    menuFrameStruct *frame = &engine->stack[engine->depth - 1];
+    const menuScreenStruct *screen = frame->screen;
+    resetInactivity(engine);
+    if (isLong) {
+        if (screen->onLong != NULL) {
+            screen->onLong(engine, frame);
+        }
+    } else if (screen->onShort != NULL) {
+        screen->onShort(engine, frame);
+    } else if (screen->optionCount > 0) {
+        incrementNumber(&frame->currentSelection, screen->firstOption + screen->optionCount - 1, screen->firstOption);
+    }
+    engine->dirty = true;
+}
+
+/**
+ * Adds the latency of a press to its transition, transitions past the first MENU_LATENCY_TRANSITIONS aren't measured.
+ *
+ * @param engine The engine.
+ * @param from The screen the press was given to.
+ * @param to The screen showing after the press.
+ * @param latencyUs The microseconds from the press being read to the screen being drawn.
+ */
+static void recordLatency(menuEngineStruct *engine, const menuScreenStruct *from, const menuScreenStruct *to,
+                          const long long latencyUs) {
+    menuLatencyStruct *transition = NULL;
+    for (int i = 0; i < engine->numberOfTransitions && transition == NULL; i++) {
+        if (engine->latency[i].from == from && engine->latency[i].to == to) {
+            transition = &engine->latency[i];
+        }
+    }
+    if (transition == NULL) {
+        if (engine->numberOfTransitions == MENU_LATENCY_TRANSITIONS) {
+            return;
+        }
+        transition = &engine->latency[engine->numberOfTransitions++];
+        transition->from = from;
+        transition->to = to;
+        transition->presses = 0;
+        transition->totalUs = 0;
+        transition->maxUs = 0;
+    }
+    transition->presses++;
+    transition->totalUs += latencyUs;
+    if (latencyUs > transition->maxUs) {
+        transition->maxUs = latencyUs;
+    }
+}
+
+/**
+ * Draws what has changed on the top screen, the whole screen if it is dirty or else only the parts it updates itself,
+ * then the progress bar of a running feed. Every change is sent to the display in the one frame. The latency of a press
+ * waiting for its frame is recorded.
+ *
+ * @param engine The engine.
+ */
+static void presentFrame(menuEngineStruct *engine) {
+    if ((engine->dirty || engine->updateDirty || engine->progressDirty) && engine->depth > 0) {
+        menuFrameStruct *frame = &engine->stack[engine->depth - 1];
+        if (engine->dirty) {
+            frame->screen->render(engine, frame);
+            //A new screen is drawn over the bar, so it is drawn again while the feed is running.
+            engine->progressDirty |= engine->feedProgress > 0 && engine->feedProgress < 100;
+        } else if (engine->updateDirty && frame->screen->renderUpdate != NULL) {
+            frame->screen->renderUpdate(engine, frame);
+        }
+        if (engine->progressDirty) {
+            displayFeedProgress(engine->feedProgress);
+        }
+        engine->dirty = false;
+        engine->updateDirty = false;
+        engine->progressDirty = false;
+        graphicsPresent(&programGraphics);
+        displayFlush(); //The screen is only drawn once every command has reached the display.
+        engine->lastFrameUs = monotonicUs();
+        engine->framesDrawn++;
+    }
+    if (engine->pressedScreen != NULL) {
+        recordLatency(engine, engine->pressedScreen,
+                      engine->depth > 0 ? engine->stack[engine->depth - 1].screen : NULL,
+                      monotonicUs() - engine->pressUs);
+        engine->pressedScreen = NULL;
+    }
+}
+
+/**
+ * Draws a frame if the top screen has changed. If the last frame was less than a frame interval ago the frame timer
+ * draws it once the interval is up instead, anything else that changes before then is drawn in the same frame.
+ *
+ * @param engine The engine.
+ */
+static void scheduleFrame(menuEngineStruct *engine) {
+    if (!engine->dirty && !engine->updateDirty && !engine->progressDirty && engine->pressedScreen == NULL) {
+        return;
+    }
+    if (engine->frameTimer.pending) {
+        engine->framesCoalesced++;
+        return;
+    }
+    const long long waitUs = engine->lastFrameUs + engine->frameIntervalUs - monotonicUs();
+    if (waitUs <= 0 || engine->depth == 0) {
+        presentFrame(engine);
+    } else {
+        timerWheelAdd(&programTimers, &engine->frameTimer, (long) ((waitUs + 999) / 1000));
+    }
+}
+
+/**
+ * Prints the press to render latency of every transition that has happened, in the order they first happened.
+ *
+ * @param engine The engine.
+ */
+void menuLatencyReport(const menuEngineStruct *engine) {
+    for (int i = 0; i < engine->numberOfTransitions; i++) {
+        const menuLatencyStruct *transition = &engine->latency[i];
+        printf("Menu latency: %s -> %s, %d presses, mean %.3fms, max %.3fms\n", transition->from->name,
+               transition->to != NULL ? transition->to->name : "Exit", transition->presses,
+               transition->totalUs / 1000.0 / transition->presses, transition->maxUs / 1000.0);
+    }
+    printf("Menu frames: %lld drawn at up to %lld a second, %lld redraws joined a waiting frame\n",
+           engine->framesDrawn, 1000000LL / engine->frameIntervalUs, engine->framesCoalesced);
+}
+
+/**
+ * The event loop. Each pass reads the button, gives any press to the top screen, lets the top screen update itself,
+ * schedules a frame if it changed and then waits half a second while the timers run, drawing the frame among them. It
+ * returns once every screen has been left and prints the latency report if menuPrintReport is set.
+ *
+ * @param engine The engine, with the first screen already pushed.
+ */
+void menuRun(menuEngineStruct *engine) {
+    timerWheelAdd(&programTimers, &engine->feedCheckTimer, 0);
+    while (engine->depth > 0) {
+        scheduleFrame(engine); //Anything the timers changed while waiting.
+        char *result = buttonState(); //Get the button state.
+        const long long pressUs = monotonicUs();
+        const bool pressed = strcmp(result, "SHORT_PRESS") == 0 || strcmp(result, "LONG_PRESS") == 0;
+        const menuScreenStruct *pressedScreen = engine->stack[engine->depth - 1].screen;
+        if (pressed) {
+            if (engine->pressedScreen != NULL) {
+                presentFrame(engine); //The last press is still waiting for its frame, so it is drawn now.
+            }
+            dispatchPress(engine, strcmp(result, "LONG_PRESS") == 0);
+            engine->pressedScreen = pressedScreen; //Its latency is recorded when its frame is drawn.
+            engine->pressUs = pressUs;
+        }
+        free(result);
+        if (engine->depth > 0) {
+            menuFrameStruct *frame = &engine->stack[engine->depth - 1];
+            if (frame->screen->onTick != NULL) {
+                frame->screen->onTick(engine, frame);
+            }
+        }
+        scheduleFrame(engine);
+        if (engine->depth > 0) {
+            timerWheelRunFor(&programTimers, MENU_POLL_MS); //Waits a half-second while running any timers that are due.
+        }
+    }
+    timerWheelCancel(&programTimers, &engine->inactivityTimer);
+    timerWheelCancel(&programTimers, &engine->feedCheckTimer);
+    timerWheelCancel(&programTimers, &engine->frameTimer);
+    if (menuPrintReport) {
+        menuLatencyReport(engine);
+    }
+}
@@ -0,0 +1,121 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the menu engine, the one event loop that runs every menu and screen.
+*
+* Each screen is a descriptor holding its render function and what a short or long press does, the engine keeps a
+* stack of the screens the user has entered. Entering a screen pushes it, leaving pops it and returns to the screen
+* below, so a sub-menu never blocks its parent in a loop of its own.
+*
+* The checks that every screen used to make itself are timers on the program timer wheel, the feed check runs every
+* half second whatever screen is showing and the inactivity timer shows the blank screen after 60 seconds without a
+* press.
+*
+* Anything that changes a screen only marks it dirty, the frame scheduler draws the latest state of the top screen at
+* most once per frame interval. A change less than a frame after the last frame is drawn by the frame timer once the
+* interval is up, however many more changes come in before then. The frame rate is 30 a second unless menuFrameRate is
+* set before the engine is initialised. Nothing reaches the display outside a frame, a screen whose clock ticks only
+* marks the clock for redrawing and the progress bar of a running feed is drawn in a frame too.
+*
+* The time from a press being read to the frame it leads to being drawn is measured for every transition between two
+* screens, a report is printed when the loop ends.
+*/
+#ifndef MENU_ENGINE_HEADER
+#define MENU_ENGINE_HEADER
+#include <stdbool.h>
+#include "operatingMode.h"
+#include "timerWheel.h"
+
+#define MENU_STACK_DEPTH 8
+#define MENU_TEXT_BUFFER 22
+#define MENU_POLL_MS 500L
+#define MENU_FEED_CHECK_MS 500L
+#define MENU_INACTIVITY_MS 60000L
+#define MENU_LATENCY_TRANSITIONS 32
+#define MENU_FRAME_RATE 30 //Frames a second.
+
+typedef struct menuEngineStruct menuEngineStruct;
+typedef struct menuFrameStruct menuFrameStruct;
+typedef void (*menuHandler)(menuEngineStruct *engine, menuFrameStruct *frame); //Something a screen does.
+
+/**
+ * The descriptor of a screen, any handler that isn't needed is NULL.
+ */
+typedef struct {
+    const char *name;
+    int optionCount; //If there is no onShort a short press cycles the selection through this many options.
+    int firstOption; //The value of the first option, the selection starts here.
+    menuHandler onEnter; //Sets up the frame when the screen is entered.
+    menuHandler render; //Draws the whole screen.
+    menuHandler onShort; //Called on a short press.
+    menuHandler onLong; //Called on a long press.
+    menuHandler onResume; //Called when the screen above it is left.
+    menuHandler onTick; //Called every pass of the loop while the screen is showing.
+    menuHandler renderUpdate; //Draws only the parts of the screen that change on their own, like the clock.
+} menuScreenStruct;
+
+/**
+ * A screen on the stack and the state it is in.
+ */
+struct menuFrameStruct {
+    const menuScreenStruct *screen;
+    int currentSelection; //The highlighted option or digit.
+    int position; //The feed in the schedule the screen is working on.
+    int step; //How far through a series of screens the screen is.
+    int target; //How many feeds a series of screens is for.
+    int digits[8]; //The digits being entered.
+    char bottomText[MENU_TEXT_BUFFER]; //A warning shown at the bottom of the screen.
+    int previousSecond; //The second the clock was last drawn at.
+    int shownNextFeed; //The next feed when the screen was drawn.
+};
+
+/**
+ * The press to render latency of one transition between two screens.
+ */
+typedef struct {
+    const menuScreenStruct *from; //The screen the press was given to.
+    const menuScreenStruct *to; //The screen showing after the press, NULL if every screen was left.
+    int presses;
+    long long totalUs;
+    long long maxUs;
+} menuLatencyStruct;
+
+/**
+ * The engine, its stack and the timers it runs.
+ */
+struct menuEngineStruct {
+    menuFrameStruct stack[MENU_STACK_DEPTH];
+    int depth; //How many screens are on the stack, the loop ends when this is 0.
+    operatingModeStruct *operatingMode; //The operating mode the screens change.
+    const menuScreenStruct *inactivityScreen; //Pushed when the user has been inactive.
+    bool dirty; //If the top screen needs redrawing.
+    bool updateDirty; //If the parts of the top screen that change on their own need redrawing.
+    int feedProgress; //How far through a feed the motor is, in percent.
+    bool progressDirty; //If the progress bar needs redrawing.
+    long long frameIntervalUs; //The least time between two frames.
+    long long lastFrameUs; //When the last frame was drawn.
+    timerStruct frameTimer; //Draws a frame that had to wait for the interval.
+    long long framesDrawn;
+    long long framesCoalesced; //Times a redraw was asked for when one was already waiting.
+    const menuScreenStruct *pressedScreen; //The screen a press waiting for its frame was given to, else NULL.
+    long long pressUs; //When that press was read.
+    int previousMinute; //The minute the feed check last ran in.
+    timerStruct inactivityTimer;
+    timerStruct feedCheckTimer;
+    menuLatencyStruct latency[MENU_LATENCY_TRANSITIONS];
+    int numberOfTransitions;
+};
+
+extern int menuFrameRate; //Frames a second, MENU_FRAME_RATE unless changed before the engine is initialised.
+extern bool menuPrintReport; //If menuRun prints the latency report when it returns.
+
+void initialiseMenuEngine(menuEngineStruct *engine, operatingModeStruct *operatingMode,
+                          const menuScreenStruct *inactivityScreen);
+menuFrameStruct *menuPush(menuEngineStruct *engine, const menuScreenStruct *screen, const int position);
+void menuPop(menuEngineStruct *engine); //Leaves the top screen and returns to the one below.
+void menuRedraw(menuEngineStruct *engine); //Marks the top screen as needing to be redrawn in the next frame.
+void menuRedrawUpdate(menuEngineStruct *engine); //Marks the parts that change on their own, like the clock.
+void menuFeedProgress(menuEngineStruct *engine, const int percentDone); //The progress bar is drawn in the next frame.
+void menuRun(menuEngineStruct *engine); //Runs the event loop until every screen has been left.
+void menuLatencyReport(const menuEngineStruct *engine); //Prints the press to render latency of each transition.
+#endif //MENU_ENGINE_HEADER
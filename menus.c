@@ -4,297 +4,313 @@
 * Functions that display and manage the menus.
 */
 #include <stdbool.h>
-#include <string.h>
-#include "fish.h"
+#include <stddef.h>
 #include "menus.h"
 #include "displayScreens.h"
+#include "eepromJournal.h"
+#include "feedHistory.h"
+#include "fish.h"
+#include "menuEngine.h"
 #include "menusFunctions.h"
 
+static menuEngineStruct mainEngine; //Static so the timers it holds stay valid for the whole program.
+
 /**
- * The select operating mode menu, the user can choose to change the operating mode from the options 'Paused',
- * 'Auto', 'Skip next feed',and 'Feed now'
+ * Draws the select operating mode menu.
  *
- * The user is also able to quit this menu and return to the configuration menu.
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
+ */
+static void renderOperatingModeMenu(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    displayOperatingModeMenu(frame->currentSelection);
+}
+
+/**
+ * Long pressing the button confirms the current selection. Different actions will then be taken depending on the
+ * current selection, then the current selection will be reset to 0.
  *
- * @param operatingMode The current operating mode that will have its mode changed.
+ * @param engine The menu engine, holding the operating mode that will have its mode changed.
+ * @param frame The menu, holding the current selection.
  */
-void selectOperatingModeMenu(operatingModeStruct *operatingMode) {
-    bool operatingModeMenu = true; //Keeps the menu active until user exits it.
-    double timeCounter = 0; //Tracks how many seconds have gone by since the last user interaction.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    int currentSelection = 0; //0 is Paused, 1 is auto, 2,is feed now , 3 is skip next feed, 4 is exit
-    displayOperatingModeMenu(currentSelection);
-    /*
-     * Loop that checks for button presses,
-     * a short press cycles through the selection options and a long press confirms the current option.
-     */
-    while (operatingModeMenu) {
-        char *result = buttonState(); //Get the button state.
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        //Checks if user has been inactive for 60 seconds.
-        if (timeCounter >= 60) {
-            blankScreen(operatingMode); //Clears the screen until the button is pressed
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displayOperatingModeMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        /*
-         * Short pressing the button allows the user to cycle through 5 options one by one. The current selection will be highlighted
-         * thus the display function needs to be called every time the selection changes.
-         */
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            incrementNumber(&currentSelection, 4, 0);
-            //Applies the relevant changes after the current selection changes.
-            interactionGenericConfiguration(displayOperatingModeMenu, currentSelection, &timeCounter);
+static void chooseOperatingMode(menuEngineStruct *engine, menuFrameStruct *frame) {
+    operatingModeStruct *operatingMode = engine->operatingMode;
+    if (frame->currentSelection == 0) {
+        //Sets the current mode to paused, this means no feeds will take place until the mode is changed.
+        operatingMode->mode = 1;
+    } else if (frame->currentSelection == 1) {
+        //Sets the current mode to auto, this means the fish will be fed according to the feed schedule.
+        operatingMode->mode = 0;
+        findNextFeed(operatingMode); //Ensures the next feed time is accurate to the feed schedule.
+    } else if (frame->currentSelection == 2) {
+        //Feeds the fish manually, this will not affect the current mode.
+        rotateFishFeeder(1,false, operatingMode);
+    } else if (frame->currentSelection == 3) {
+        //Skips the next feed and goes to the next feed in the current schedule.
+        if (operatingMode->numberOfFeedsInADay > 0) {
+            //Ensures there actually a feed schedule to get the next feed from.
+            feedHistoryAppend(&programHistory, rtcTimestamp(), FEED_EVENT_SKIPPED,
+                              operatingMode->feedTimes[operatingMode->nextFeed].rotations, 0);
+            incrementNumber(&operatingMode->nextFeed, operatingMode->numberOfFeedsInADay - 1, 0);
         }
-        /*
-         * Long pressing the button confirms the current selection. Different actions will then be taken depending on the current
-         * selection.The current selection will be reset to 0 and the select operating mode menu will be displayed as well as the time counter being reset.
-         */
-        if (strcmp(result, "LONG_PRESS") == 0) {
-            if (currentSelection == 0) {
-                //Sets the current mode to paused, this means no feeds will take place until the mode is changed.
-                operatingMode->mode = 1;
-            } else if (currentSelection == 1) {
-                //Sets the current mode to auto, this means the fish will be fed according to the feed schedule.
-                operatingMode->mode = 0;
-                findNextFeed(operatingMode); //Ensures the next feed time is accurate to the feed schedule.
-            } else if (currentSelection == 2) {
-                //Feeds the fish manually, this will not affect the current mode.
-                rotateFishFeeder(1,false, operatingMode);
-            } else if (currentSelection == 3) {
-                //Skips the next feed and goes to the next feed in the current schedule.
-                if (operatingMode->numberOfFeedsInADay > 0) {
-                    //Ensures there actually a feed schedule to get the next feed from.
-                    incrementNumber(&operatingMode->nextFeed, operatingMode->numberOfFeedsInADay - 1, 0);
-                }
-            } else {
-                operatingModeMenu = false; //Exits the loop.
-            }
-            currentSelection = 0;
-            //Applies the relevant changes after the current selection changes.
-            interactionGenericConfiguration(displayOperatingModeMenu, currentSelection, &timeCounter);
+    } else {
+        menuPop(engine); //Exits the menu.
+    }
+    journalRecordChanges(&programJournal); //The mode or next feed may have changed.
+    frame->currentSelection = 0;
+}
+
+/**
+ * The select operating mode menu, the user can choose to change the operating mode from the options 'Paused',
+ * 'Auto', 'Feed now', and 'Skip next feed'. The user is also able to quit this menu and return to the configuration menu.
+ */
+static const menuScreenStruct selectOperatingModeMenu = {
+    "Select operating mode", 5, 0, NULL, renderOperatingModeMenu, NULL, chooseOperatingMode, NULL, NULL, NULL
+};
+
+/**
+ * Draws the configure feed schedule menu.
+ *
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
+ */
+static void renderConfigFeedScheduleMenu(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    displayConfigFeedScheduleMenu(frame->currentSelection);
+}
+
+/**
+ * Long pressing the button confirms the current selection, either entering the new schedule or edit schedule screen
+ * or leaving the menu. The current selection will be reset to 0.
+ *
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
+ */
+static void chooseFeedScheduleOption(menuEngineStruct *engine, menuFrameStruct *frame) {
+    const int selection = frame->currentSelection;
+    frame->currentSelection = 0;
+    if (selection == 0) {
+        //Enters a screen where the user is able to create a new schedule.
+        menuPush(engine, &createNewScheduleScreen, 0);
+    } else if (selection == 1) {
+        if (engine->operatingMode->numberOfFeedsInADay != 0) {
+            //Checks that a schedule exists to edit.
+            //Enters a screen where the user is able to edit the current schedule.
+            menuPush(engine, &editCurrentScheduleScreen, 0);
         }
-        loopEnd(result, &timeCounter); //Ensures 0.5 seconds pass and updates/resets variables accordingly.
+    } else {
+        menuPop(engine); //Exits the menu.
     }
 }
 
 /**
  * The configure feed schedule menu, the user can choose to create a new feed schedule or edit the current one.
  * The user is also able to quit this menu and return to the configuration menu.
+ */
+static const menuScreenStruct configureFeedScheduleMenu = {
+    "Configure feed schedule", 3, 0, NULL, renderConfigFeedScheduleMenu, NULL, chooseFeedScheduleOption, NULL, NULL,
+    NULL
+};
+
+/**
+ * Draws the set the clock menu.
  *
- * @param operatingMode The current operating mode that will have its feed schedule changed.
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
  */
-void configureFeedScheduleMenu(operatingModeStruct *operatingMode) {
-    bool configFeedSchedule = true; //Keeps the menu active until user exits it.
-    double timeCounter = 0; //Tracks how many seconds have gone by since the last user interaction.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    int currentSelection = 0; // 0 is new schedule,1 is edit schedule, 2 is exit.
-    displayConfigFeedScheduleMenu(currentSelection);
-    /*
-     * Loop that checks for button presses,
-     * a short press cycles through the selection options and a long press confirms the current option.
-     */
-    while (configFeedSchedule) {
-        char *result = buttonState(); //Get the button state.
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        //Checks if user has been inactive for 60 seconds.
-        if (timeCounter >= 60) {
-            blankScreen(operatingMode); //Clears the screen until the button is pressed
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displayConfigFeedScheduleMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        /*
-         * Short pressing the button allows the user to cycle through 3 options one by one. The current selection will be highlighted
-         * thus the display function needs to be called every time the selection changes.
-         */
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            incrementNumber(&currentSelection, 2, 0);
-            //Applies the relevant changes after the current selection changes.
-            interactionGenericConfiguration(displayConfigFeedScheduleMenu, currentSelection, &timeCounter);
-        }
-        /*
-         * Long pressing the button confirms the current selection. Different actions will then be taken depending on the current
-         * selection. The configure feed schedule menu will be reset and displayed after the selected action is complete.
-         * The current selection will also be reset to 0.
-         */
-        if (strcmp(result, "LONG_PRESS") == 0) {
-            if (currentSelection == 0) {
-                //Enters a screen where the user is able to create a new schedule.
-                createNewScheduleScreen(operatingMode);
-            } else if (currentSelection == 1) {
-                if (operatingMode->numberOfFeedsInADay != 0) {
-                    //Checks that a schedule exists to edit.
-                    //Enters a screen where the user is able to edit the current schedule.
-                    editCurrentSchedule(operatingMode);
-                }
-            } else {
-                configFeedSchedule = false; //Exits the loop
-            }
-            currentSelection = 0;
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displayConfigFeedScheduleMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        loopEnd(result, &timeCounter); //Ensures 0.5 seconds pass and updates/resets variables accordingly.
+static void renderSetTheClockMenu(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    displaySetTheClockMenu(frame->currentSelection);
+}
+
+/**
+ * Long pressing the button confirms the current selection, either entering the set the date or set the time screen
+ * or leaving the menu. The current selection will be reset to 0.
+ *
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
+ */
+static void chooseClockOption(menuEngineStruct *engine, menuFrameStruct *frame) {
+    const int selection = frame->currentSelection;
+    frame->currentSelection = 0;
+    if (selection == 0) {
+        menuPush(engine, &setTheDateScreen, 0); //Enters a screen where the user can change the systems current date.
+    } else if (selection == 1) {
+        menuPush(engine, &setTheTimeScreen, 0); //Enters a screen where the user can change the systems current time.
+    } else {
+        menuPop(engine); //Exits the menu.
     }
 }
 
 /**
  * The set the clock menu, you can choose to change the time or change the date.
  * The user is also able to quit this menu and return to the configuration menu.
+ */
+static const menuScreenStruct setTheClockMenu = {
+    "Set the clock", 3, 0, NULL, renderSetTheClockMenu, NULL, chooseClockOption, NULL, NULL, NULL
+};
+
+/**
+ * Draws the configuration menu.
  *
- * @param operatingMode The operating mode is passed to allow for constant checks for if it's time to feed the fish.
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
  */
-void setTheClockMenu(operatingModeStruct *operatingMode) {
-    bool selectTimeChangeType = true; //Keeps the menu active until user exits it.
-    double timeCounter = 0; //Tracks how many seconds have gone by since the last user interaction.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    int currentSelection = 0; //0 is set the date, 1 is set the time, 2 is exit.
-    displaySetTheClockMenu(currentSelection);
-    /*
-     * Loop that checks for button presses,
-     * a short press cycles through the selection options and a long press confirms the current option.
-     */
-    while (selectTimeChangeType) {
-        char *result = buttonState(); //Get the button state.
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        //Checks if user has been inactive for 60 seconds.
-        if (timeCounter >= 60) {
-            blankScreen(operatingMode); //Clears the screen until the button is pressed
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displaySetTheClockMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        /*
-         * Short pressing the button allows the user to cycle through 3 options one by one. The current selection will be highlighted
-         * thus the display function needs to be called every time the selection changes.
-         */
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            incrementNumber(&currentSelection, 2, 0);
-            //Applies the relevant changes after the current selection changes.
-            interactionGenericConfiguration(displaySetTheClockMenu, currentSelection, &timeCounter);
-        }
-        /*
-         * Long pressing the button confirms the current selection. Different actions will then be taken depending on the current
-         * selection.The set the clock menu will be reset and displayed after the selected action is complete.
-         * The current selection will also be reset to 0.
-         */
-        if (strcmp(result, "LONG_PRESS") == 0) {
-            if (currentSelection == 0) {
-                setTheDate(operatingMode); //Enters a screen where the user can change the systems current date.
-            } else if (currentSelection == 1) {
-                setTheTime(operatingMode); //Enters a screen where the user can change the systems current time.
-            } else {
-                selectTimeChangeType = false; //Exits the loop.
-            }
-            currentSelection = 0;
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displaySetTheClockMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        loopEnd(result, &timeCounter); //Ensures 0.5 seconds pass and updates/resets variables accordingly.
+static void renderConfigurationMenu(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    displayConfigurationMenu(frame->currentSelection);
+}
+
+/**
+ * Long pressing the button confirms the current selection, entering one of the other menus or leaving the menu.
+ * The current selection will be reset to 0.
+ *
+ * @param engine The menu engine.
+ * @param frame The menu, holding the current selection.
+ */
+static void chooseConfigurationOption(menuEngineStruct *engine, menuFrameStruct *frame) {
+    const int selection = frame->currentSelection;
+    frame->currentSelection = 0;
+    if (selection == 0) {
+        menuPush(engine, &setTheClockMenu, 0); //Enters a menu where you can set the clock to a different time or date.
+    } else if (selection == 1) {
+        //Enters a menu where you can configure the operating modes feed schedule.
+        menuPush(engine, &configureFeedScheduleMenu, 0);
+    } else if (selection == 2) {
+        menuPush(engine, &selectOperatingModeMenu, 0); //Enters a menu where you can select the current operating mode.
+    } else {
+        menuPop(engine); //Exits the menu.
     }
 }
 
 /**
  * The configuration menu, further menus that can edit the system, operating mode or the feed schedule are displayed.
  * The user is also able to quit this menu and return to the main screen.
+ */
+static const menuScreenStruct configurationMenu = {
+    "Configuration", 4, 0, NULL, renderConfigurationMenu, NULL, chooseConfigurationOption, NULL, NULL, NULL
+};
+
+/**
+ * Draws the whole main screen, including the time.
  *
- * @param operatingMode The operating mode that will be edited and used for checks.
+ * @param engine The menu engine, holding the operating mode to be displayed.
+ * @param frame The main screen.
  */
-void configurationMenu(operatingModeStruct *operatingMode) {
-    bool selectConfigMenu = true; //Keeps the menu active until user exits it.
-    double timeCounter = 0; //Tracks how many seconds have gone by since the last user interaction.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    int currentSelection = 0; //O is set the clock, 1 is config feed schedule, 2 is select operating mode, 3 is exit.
-    displayConfigurationMenu(currentSelection);
-    /*
-     * Loop that checks for button presses,
-     * a short press cycles through the selection options and a long press confirms the current option.
-     */
-    while (selectConfigMenu) {
-        char *result = buttonState(); // Get the button state.
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        //Checks if user has been inactive for 60 seconds.
-        if (timeCounter >= 60) {
-            blankScreen(operatingMode); //Clears the screen until the button is pressed.
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displayConfigurationMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        /*
-         * Short pressing the button allows the user to cycle through 4 options one by one. The current selection will be highlighted
-         * thus the display function needs to be called every time the selection changes.
-         */
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            incrementNumber(&currentSelection, 3, 0);
-            //Applies the relevant changes after the current selection changes.
-            interactionGenericConfiguration(displayConfigurationMenu, currentSelection, &timeCounter);
-        }
-        /*
-         * Long pressing the button confirms the current selection. Different actions will then be taken depending on the current
-         * selection. The configuration menu will be reset and displayed after the selected action is complete.
-         * The current selection will also be reset to 0.
-         */
-        if (strcmp(result, "LONG_PRESS") == 0) {
-            if (currentSelection == 0) {
-                setTheClockMenu(operatingMode); //Enters a menu where you can set the clock to a different time or date.
-            } else if (currentSelection == 1) {
-                //Enters a menu where you can configure the operating modes feed schedule.
-                configureFeedScheduleMenu(operatingMode);
-            } else if (currentSelection == 2) {
-                selectOperatingModeMenu(operatingMode); //Enters a menu where you can select the current operating mode.
-            } else {
-                selectConfigMenu = false; //Exits the loop.
-            }
-            currentSelection = 0;
-            //Resets the menu after returning to the screen.
-            resetGenericConfiguration(displayConfigurationMenu, currentSelection, &timeCounter, &previousMinute);
-        }
-        loopEnd(result, &timeCounter); //Ensures 0.5 seconds pass and updates/resets variables accordingly.
+static void renderMainScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    displayMainScreen(engine->operatingMode);
+    frame->shownNextFeed = engine->operatingMode->nextFeed;
+    frame->previousSecond = -1; //The time is always drawn onto a new screen.
+    updateTimeDisplay(&frame->previousSecond);
+}
+
+/**
+ * Keeps the main screen up to date, the time is redrawn in the next frame when the second changes and the whole screen
+ * is redrawn if the next feed has changed.
+ *
+ * @param engine The menu engine.
+ * @param frame The main screen.
+ */
+static void tickMainScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    if (frame->shownNextFeed != engine->operatingMode->nextFeed) {
+        menuRedraw(engine); //If the next feed has changed re-display menu.
+    } else if (clockSecond() != frame->previousSecond) {
+        menuRedrawUpdate(engine); //Only the time is redrawn.
     }
 }
 
+/**
+ * Redraws the time on the main screen.
+ *
+ * @param engine The menu engine.
+ * @param frame The main screen.
+ */
+static void updateMainScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    updateTimeDisplay(&frame->previousSecond);
+}
+
+/**
+ * A short press enters the configuration menu.
+ *
+ * @param engine The menu engine.
+ * @param frame The main screen.
+ */
+static void openConfigurationMenu(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) frame;
+    menuPush(engine, &configurationMenu, 0);
+}
+
+/**
+ * A long press leaves the main screen, which ends the program.
+ *
+ * @param engine The menu engine.
+ * @param frame The main screen.
+ */
+static void quitMainScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) frame;
+    menuPop(engine);
+}
+
+/**
+ * The main menu, information about the current operating mode and the system is displayed.
+ */
+static const menuScreenStruct mainMenu = {
+    "Main", 0, 0, NULL, renderMainScreen, openConfigurationMenu, quitMainScreen, NULL, tickMainScreen, updateMainScreen
+};
+
+/**
+ * Blanks the display, nothing else is drawn until the blank screen is left.
+ *
+ * @param engine The menu engine.
+ * @param frame The blank screen.
+ */
+static void renderBlankScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) engine;
+    (void) frame;
+    setScreenBlanked(true);
+}
+
+/**
+ * Short pressing the button allows the user to return to the previous screen they were on.
+ *
+ * @param engine The menu engine.
+ * @param frame The blank screen.
+ */
+static void leaveBlankScreen(menuEngineStruct *engine, menuFrameStruct *frame) {
+    (void) frame;
+    setScreenBlanked(false);
+    menuPop(engine);
+}
+
+/**
+ * The blank screen, shown while there is inactivity so to stop burn out of the oled screen.
+ */
+static const menuScreenStruct blankScreen = {
+    "Blank", 0, 0, NULL, renderBlankScreen, leaveBlankScreen, NULL, NULL, NULL, NULL
+};
+
 /**
  * The main menu, information about the current operating mode and the system is displayed.
  * The user is also able to either quit the program or enter the configuration menu.
+ * This runs the menu engine until the user quits.
  *
  * @param operatingMode The operating mode that will be edited and used for checks.
  */
 void mainScreen(operatingModeStruct *operatingMode) {
-    bool runningMainScreen = true; //Keeps the menu active until user exits it.
-    double timeCounter = 0; //Tracks how many seconds have gone by since the last user interaction.
-    int previousMinute = -1; //Allows detection when minutes value has changed.
-    int previousSecond = -1; //Allows detection when seconds value has changed.
-    int nextFeed = operatingMode->nextFeed;
-    displayMainScreen(operatingMode);
-    /*
-     * Loop that checks for button presses,
-     * a short press enters the configuration menu and a long press exits the loop.
-     * When the loop is exited the program will end.
-     */
-    while (runningMainScreen) {
-        char *result = buttonState(); // Gets the button state.
-        updateTimeDisplay(&previousSecond); //Updates the time display.
-        //Checks if the minute has changed and if it's time to feed fish.
-        checkIfItsTimeToFeedFish(operatingMode, &previousMinute);
-        if (nextFeed != operatingMode->nextFeed) {
-            //If the next feed has changed re-display menu.
-            displayMainScreen(operatingMode);
-            nextFeed = operatingMode->nextFeed; //updates the next feed
-        }
-        //Checks if user has been inactive for 60 seconds.
-        if (timeCounter >= 60) {
-            blankScreen(operatingMode); //Clears the screen until the button is pressed.
-            resetMainScreen(operatingMode, &timeCounter, &previousMinute); //Resets the screen after returning.
-        }
-        if (strcmp(result, "LONG_PRESS") == 0) {
-            runningMainScreen = false; //Exits the loop.
-        }
-        if (strcmp(result, "SHORT_PRESS") == 0) {
-            configurationMenu(operatingMode); //Runs and displays the configuration menu.
-            resetMainScreen(operatingMode, &timeCounter, &previousSecond); //Resets the screen after returning.
-        }
-        loopEnd(result, &timeCounter); //Ensures 0.5 seconds pass and updates/resets variables accordingly.
+    initialiseMenuEngine(&mainEngine, operatingMode, &blankScreen);
+    menuPush(&mainEngine, &mainMenu, 0);
+    menuRun(&mainEngine);
+}
+
+/**
+ * The motor controller's progress callback, the progress bar is drawn in the next frame of the menus. Nothing is drawn
+ * once the menus have been left.
+ *
+ * @param percentDone How much of the feed has been done.
+ */
+void showFeedProgress(const int percentDone) {
+    if (mainEngine.depth > 0) {
+        menuFeedProgress(&mainEngine, percentDone);
     }
 }
@@ -0,0 +1,260 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The motor controller, a state machine stepped by the program timer wheel.
+*/
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "fish.h"
+#include "motorController.h"
+
+/**
+ * Feeds start at the old fixed speed of one step every 40ms and ramp up to twice that speed.
+ */
+const motorProfileStruct feedProfile = {PROFILE_TRAPEZOIDAL, MOTOR_STEP_DELAY_MS * 1000L, 20000L, 30};
+
+bool motorPrintTiming = false;
+
+static motorControllerStruct motor;
+static motorTimingReportStruct lastTimingReport;
+
+/**
+ * Tells the progress callback how much of the job is done, only when the percentage has changed.
+ */
+static void reportProgress() {
+    const int percentDone = motor.stepsDone * 100 / motor.totalSteps;
+    if (percentDone != motor.lastPercentReported && motor.onProgress != NULL) {
+        motor.lastPercentReported = percentDone;
+        motor.onProgress(percentDone);
+    }
+}
+
+/**
+ * Works out how long the motor waits before making a step. The speed (steps per second) is ramped between the start and
+ * cruise speeds over the first and last rampSteps of the job, if the job is too short to reach cruise speed the ramps
+ * meet in the middle.
+ *
+ * @param profile The acceleration profile of the job.
+ * @param step The index of the step, starting at 0.
+ * @param totalSteps How many steps the job has.
+ * @return The microseconds between the previous step and this one.
+ */
+long motorStepIntervalUs(const motorProfileStruct *profile, const int step, const int totalSteps) {
+    int rampSteps = profile->rampSteps;
+    if (rampSteps > totalSteps / 2) {
+        rampSteps = totalSteps / 2;
+    }
+    if (profile->type == PROFILE_CONSTANT || rampSteps <= 0) {
+        return profile->startIntervalUs;
+    }
+    //How far through the nearest ramp the step is, 0 is standing still and 1 is cruising.
+    const int stepsFromEnd = step < totalSteps - 1 - step ? step : totalSteps - 1 - step;
+    double rampPosition = (double) (stepsFromEnd + 1) / rampSteps;
+    if (rampPosition > 1) {
+        rampPosition = 1;
+    }
+    if (profile->type == PROFILE_S_CURVE) {
+        rampPosition = rampPosition * rampPosition * (3 - 2 * rampPosition); //Smoothstep eases in and out.
+    }
+    const double startSpeed = 1.0 / profile->startIntervalUs;
+    const double cruiseSpeed = 1.0 / profile->cruiseIntervalUs;
+    return (long) (1.0 / (startSpeed + (cruiseSpeed - startSpeed) * rampPosition));
+}
+
+/**
+ * Custom function for qsort that orders jitter values from smallest to largest.
+ *
+ * @param value1 A pointer to the first value.
+ * @param value2 A pointer to the second value.
+ * @return Negative if the first value is smaller, positive if it is larger and 0 if they are equal.
+ */
+static int compareJitter(const void *value1, const void *value2) {
+    const long jitter1 = *(const long *) value1;
+    const long jitter2 = *(const long *) value2;
+    return (jitter1 > jitter2) - (jitter1 < jitter2);
+}
+
+/**
+ * Works out the timing report of the job that has just finished from how late each step was, then prints it if
+ * motorPrintTiming is set.
+ * Since every step is due a fixed time after the one before it, the interval jitter of a step is the change in lateness
+ * from the step before it.
+ */
+static void buildTimingReport() {
+    static long intervalJitter[MOTOR_TIMING_SAMPLES];
+    const int steps = motor.stepsDone < MOTOR_TIMING_SAMPLES ? motor.stepsDone : MOTOR_TIMING_SAMPLES;
+    long long totalJitter = 0;
+    lastTimingReport.steps = steps;
+    lastTimingReport.maxLatenessUs = 0;
+    for (int i = 0; i < steps; i++) {
+        intervalJitter[i] = labs(motor.latenessUs[i] - (i > 0 ? motor.latenessUs[i - 1] : 0));
+        totalJitter += intervalJitter[i];
+        if (motor.latenessUs[i] > lastTimingReport.maxLatenessUs) {
+            lastTimingReport.maxLatenessUs = motor.latenessUs[i];
+        }
+    }
+    qsort(intervalJitter, (size_t) steps, sizeof(long), compareJitter);
+    lastTimingReport.meanIntervalJitterUs = steps > 0 ? (double) totalJitter / steps : 0;
+    lastTimingReport.p99IntervalJitterUs = steps > 0 ? intervalJitter[(steps - 1) * 99 / 100] : 0;
+    lastTimingReport.actualUs = monotonicUs() - motor.startUs;
+    lastTimingReport.plannedUs = 0;
+    for (int i = 1; i < motor.totalSteps; i++) {
+        lastTimingReport.plannedUs += motorStepIntervalUs(&motor.profile, i, motor.totalSteps);
+    }
+    if (!motorPrintTiming) {
+        return;
+    }
+    printf("Motor: %d steps in %lldms (planned %lldms), interval jitter mean %.2fms p99 %.2fms, max lateness %.2fms\n",
+           motor.stepsDone, lastTimingReport.actualUs / 1000, lastTimingReport.plannedUs / 1000,
+           lastTimingReport.meanIntervalJitterUs / 1000, lastTimingReport.p99IntervalJitterUs / 1000.0,
+           lastTimingReport.maxLatenessUs / 1000.0);
+}
+
+/**
+ * Ends the current job, the feeder is refilled and the completion callback called.
+ */
+static void finishJob() {
+    if (motor.stepsDone > 0) {
+        buildTimingReport();
+    }
+    motor.running = false;
+    foodFill(50); //Refills the fish feeder after a feed.
+    if (motor.onComplete != NULL) {
+        motor.onComplete(motor.completeContext);
+    }
+}
+
+/**
+ * Arms the step timer for when the next step is due.
+ */
+static void armStepTimer() {
+    const long long delayUs = motor.nextStepDueUs - monotonicUs();
+    //Rounded up so the timer doesn't fire before the step is due.
+    timerWheelAdd(&programTimers, &motor.stepTimer, delayUs > 0 ? (long) ((delayUs + 999) / 1000) : 0);
+}
+
+/**
+ * Called by the timer wheel when the next step is due, one step is made. Each step is due a fixed interval after the one
+ * before it rather than after the timer fired, so lateness doesn't build up over a job. A step made so late that the
+ * next one is already due moves the rest of the job back instead, so the motor never makes a burst of steps faster than
+ * the profile allows.
+ *
+ * @param timer The motors step timer.
+ * @param context Unused.
+ */
+static void stepDue(timerStruct *timer, void *context) {
+    (void) timer;
+    (void) context;
+    const long long nowUs = monotonicUs();
+    if (motor.stepsDone < MOTOR_TIMING_SAMPLES) {
+        motor.latenessUs[motor.stepsDone] = (long) (nowUs - motor.nextStepDueUs);
+    }
+    motorStep();
+    motor.stepsDone++;
+    reportProgress();
+    if (motor.stepsDone < motor.totalSteps) {
+        const long intervalUs = motorStepIntervalUs(&motor.profile, motor.stepsDone, motor.totalSteps);
+        motor.nextStepDueUs += intervalUs;
+        if (motor.nextStepDueUs <= nowUs) {
+            motor.nextStepDueUs = nowUs + intervalUs; //The rest of the job is planned from this step.
+        }
+        armStepTimer();
+    } else {
+        finishJob();
+    }
+}
+
+/**
+ * Sets up the motor controller, this must be called after the program timer wheel is initialised.
+ *
+ * @param onProgress Called with the percentage done as a job progresses, can be NULL.
+ */
+void initialiseMotorController(motorProgressCallback onProgress) {
+    motor.running = false;
+    motor.stepsDone = 0;
+    motor.totalSteps = 0;
+    motor.lastPercentReported = -1;
+    motor.profile = feedProfile;
+    motor.onProgress = onProgress;
+    motor.onComplete = NULL;
+    motor.completeContext = NULL;
+    initialiseTimer(&motor.stepTimer, stepDue, NULL);
+}
+
+/**
+ * Starts a move of the motor, this returns straight away and the steps are made by the event loop.
+ * If a job is already running the steps are added onto it and keep its profile.
+ *
+ * @param steps How many steps to make.
+ * @param profile The acceleration profile of the move.
+ * @param onComplete Called when the job finishes, can be NULL. Ignored if the steps are added to a running job.
+ * @param context Passed to onComplete.
+ * @return True if a new job was started, false if the steps were added to the running job.
+ */
+bool motorRun(const int steps, const motorProfileStruct *profile, motorCompleteCallback onComplete, void *context) {
+    if (motor.running) {
+        motor.totalSteps += steps;
+        return false;
+    }
+    motor.running = true;
+    motor.stepsDone = 0;
+    motor.totalSteps = steps;
+    motor.lastPercentReported = -1;
+    motor.profile = *profile;
+    motor.onComplete = onComplete;
+    motor.completeContext = context;
+    if (motor.totalSteps <= 0) {
+        finishJob(); //Nothing to turn.
+        return true;
+    }
+    motor.nextStepDueUs = monotonicUs(); //The first step is made straight away.
+    motor.startUs = motor.nextStepDueUs;
+    armStepTimer();
+    return true;
+}
+
+/**
+ * Starts rotating the feeder using the feed profile.
+ *
+ * @param rotations How many whole rotations to make.
+ * @param onComplete Called when the job finishes, can be NULL. Ignored if the rotations are added to a running job.
+ * @param context Passed to onComplete.
+ * @return True if a new job was started, false if the rotations were added to the running job.
+ */
+bool motorStartRotations(const int rotations, motorCompleteCallback onComplete, void *context) {
+    return motorRun(rotations * STEPS_PER_ROTATION, &feedProfile, onComplete, context);
+}
+
+/**
+ * @return If the motor is turning.
+ */
+bool motorBusy() {
+    return motor.running;
+}
+
+/**
+ * @return The percentage of the current job that is done, or -1 if the motor is idle.
+ */
+int motorProgress() {
+    if (!motor.running) {
+        return -1;
+    }
+    return motor.stepsDone * 100 / motor.totalSteps;
+}
+
+/**
+ * @return The timing report of the last job that finished.
+ */
+motorTimingReportStruct motorLastTimingReport() {
+    return lastTimingReport;
+}
+
+/**
+ * Keeps running the event loop until the motor is idle. Used before the program exits so a feed isn't cut short.
+ */
+void motorWaitUntilIdle() {
+    while (motor.running) {
+        timerWheelRunFor(&programTimers, 100L);
+    }
+}
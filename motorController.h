@@ -0,0 +1,84 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the motor controller, which turns the feeder without blocking the menus.
+*
+* A job is a number of steps made by a timer on the program timer wheel, so the motor turns while the menus wait for
+* button presses. The time between steps follows an acceleration profile so the motor can cruise faster than it can start.
+* Progress and completion are reported through callbacks.
+*/
+#ifndef MOTOR_CONTROLLER_HEADER
+#define MOTOR_CONTROLLER_HEADER
+#include <stdbool.h>
+#include "timerWheel.h"
+
+#define STEPS_PER_ROTATION 360
+#define MOTOR_STEP_DELAY_MS 40L
+
+typedef void (*motorProgressCallback)(const int percentDone); //Called when the progress of a job changes.
+typedef void (*motorCompleteCallback)(void *context); //Called when a job has finished.
+
+/**
+ * How the speed of the motor changes at the start and end of a job.
+ */
+typedef enum {
+    PROFILE_CONSTANT, //Every step takes the start interval.
+    PROFILE_TRAPEZOIDAL, //The speed changes linearly.
+    PROFILE_S_CURVE //The speed changes smoothly, easing in and out of the ramp.
+} motorProfileType;
+
+/**
+ * An acceleration profile, the motor ramps from the start interval to the cruise interval and back down again at the end.
+ */
+typedef struct {
+    motorProfileType type;
+    long startIntervalUs; //Microseconds between steps when starting and stopping.
+    long cruiseIntervalUs; //Microseconds between steps at full speed.
+    int rampSteps; //How many steps the speed changes over at each end of a job.
+} motorProfileStruct;
+
+#define MOTOR_TIMING_SAMPLES 4096
+
+/**
+ * How closely the steps of a job kept to the times the profile gave them.
+ * Interval jitter is how far each gap between steps was from the gap that was planned.
+ */
+typedef struct {
+    int steps; //How many steps were timed.
+    long long plannedUs; //How long the job should have taken.
+    long long actualUs; //How long the job took.
+    double meanIntervalJitterUs; //The average interval jitter.
+    long p99IntervalJitterUs; //99% of steps had less interval jitter than this.
+    long maxLatenessUs; //The latest any step was made after it was due.
+} motorTimingReportStruct;
+
+/**
+ * The state of the motor and the job it is doing.
+ */
+typedef struct {
+    bool running; //If a job is in progress.
+    int stepsDone; //How many steps of the job have been made.
+    int totalSteps; //How many steps the job has.
+    int lastPercentReported; //The last progress sent to the progress callback.
+    motorProfileStruct profile; //The profile of the current job.
+    long long nextStepDueUs; //The monotonic time the next step is due.
+    long long startUs; //When the first step of the job was due.
+    long latenessUs[MOTOR_TIMING_SAMPLES]; //How late each step was made, used for the timing report.
+    timerStruct stepTimer; //Fires when the next step is due.
+    motorProgressCallback onProgress;
+    motorCompleteCallback onComplete;
+    void *completeContext; //Passed to onComplete.
+} motorControllerStruct;
+
+extern const motorProfileStruct feedProfile; //The profile used for feeding.
+extern bool motorPrintTiming; //If the timing report of each job is printed when it finishes.
+
+void initialiseMotorController(motorProgressCallback onProgress); //Sets up the controller, the callback may be NULL.
+long motorStepIntervalUs(const motorProfileStruct *profile, const int step, const int totalSteps); //Time before a step.
+bool motorRun(const int steps, const motorProfileStruct *profile, motorCompleteCallback onComplete, void *context);
+bool motorStartRotations(const int rotations, motorCompleteCallback onComplete, void *context); //Starts a feed.
+bool motorBusy(); //If the motor is turning.
+int motorProgress(); //Percentage of the current job done, or -1 if the motor is idle.
+void motorWaitUntilIdle(); //Runs the event loop until the current job is finished.
+motorTimingReportStruct motorLastTimingReport(); //The timing of the last finished job.
+#endif //MOTOR_CONTROLLER_HEADER
@@ -0,0 +1,326 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The multi-feeder mode, hosting many headless feeders in one process with a shared scheduler and worker pool.
+*/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fish.h"
+#include "menusFunctions.h"
+#include "motorController.h"
+#include "multiFeeder.h"
+#include "programShutdown.h"
+#include "programStartup.h"
+#define SECONDS_IN_DAY 86400
+
+static volatile sig_atomic_t stopRequested = 0; //Set when the process is asked to stop.
+
+/**
+ * Signal handler that asks the multi-feeder mode to stop, the feeders are then saved before the process exits.
+ *
+ * @param signalNumber The signal received.
+ */
+static void requestStop(int signalNumber) {
+    (void) signalNumber;
+    stopRequested = 1;
+}
+
+/**
+ * Adds work to the end of the work queue and wakes a worker to do it.
+ *
+ * @param host The host whose workers will do the work.
+ * @param function The function a worker will call.
+ * @param context Passed to the function.
+ * @return If the work was queued, false if the queue is full.
+ */
+bool hostSubmitWork(feederHostStruct *host, workFunction function, void *context) {
+    pthread_mutex_lock(&host->workLock);
+    if (host->workCount == WORK_QUEUE_SIZE) {
+        pthread_mutex_unlock(&host->workLock);
+        return false;
+    }
+    workItemStruct *item = &host->workQueue[(host->workHead + host->workCount) % WORK_QUEUE_SIZE];
+    item->function = function;
+    item->context = context;
+    host->workCount++;
+    pthread_cond_signal(&host->workAvailable);
+    pthread_mutex_unlock(&host->workLock);
+    return true;
+}
+
+/**
+ * @param host The host.
+ * @return If the host is still running, read under the work lock since the host is stopped from another thread.
+ */
+static bool hostRunning(feederHostStruct *host) {
+    pthread_mutex_lock(&host->workLock);
+    const bool running = host->running;
+    pthread_mutex_unlock(&host->workLock);
+    return running;
+}
+
+/**
+ * A worker thread, takes work from the front of the queue and does it until the host stops.
+ *
+ * @param context The host the worker belongs to.
+ * @return NULL
+ */
+static void *workerThread(void *context) {
+    feederHostStruct *host = context;
+    pthread_mutex_lock(&host->workLock);
+    while (host->running) {
+        if (host->workCount == 0) {
+            pthread_cond_wait(&host->workAvailable, &host->workLock);
+            continue;
+        }
+        const workItemStruct item = host->workQueue[host->workHead];
+        host->workHead = (host->workHead + 1) % WORK_QUEUE_SIZE;
+        host->workCount--;
+        pthread_mutex_unlock(&host->workLock);
+        item.function(item.context); //The work is done without holding the lock so the workers run in parallel.
+        pthread_mutex_lock(&host->workLock);
+    }
+    pthread_mutex_unlock(&host->workLock);
+    return NULL;
+}
+
+/**
+ * The scheduler thread, it advances the wheel holding every feeders next feed and sleeps until the next one is due.
+ *
+ * @param context The host the scheduler belongs to.
+ * @return NULL
+ */
+static void *schedulerThread(void *context) {
+    feederHostStruct *host = context;
+    pthread_mutex_lock(&host->wheelLock);
+    while (host->running) {
+        timerWheelAdvance(&host->wheel, monotonicMs());
+        const long long wake = timerWheelNextWakeMs(&host->wheel);
+        if (wake < 0) {
+            pthread_cond_wait(&host->wheelChanged, &host->wheelLock);
+        } else {
+            //Condition variables wait on the real time clock so the wake up time is converted to it.
+            const long long waitMs = wake - monotonicMs();
+            if (waitMs > 0) {
+                struct timespec deadline;
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += (time_t) (waitMs / 1000);
+                deadline.tv_nsec += (long) (waitMs % 1000) * 1000000;
+                if (deadline.tv_nsec >= 1000000000) {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000;
+                }
+                pthread_cond_timedwait(&host->wheelChanged, &host->wheelLock, &deadline);
+            }
+        }
+    }
+    pthread_mutex_unlock(&host->wheelLock);
+    return NULL;
+}
+
+/**
+ * Saves a feeder to its own save file, the feeders clock offset is saved as its warm start value.
+ * The feeders lock must be held.
+ *
+ * @param feeder The feeder to be saved.
+ */
+static void saveFeeder(const feederInstanceStruct *feeder) {
+    writeEEPROMFile(feeder->eepromFilename, &feeder->operatingMode, feeder->backend.rtcOffsetSeconds);
+}
+
+/**
+ * Work that feeds the fish of one feeder, the motor is rotated for the next feeds number of rotations, the next feed is
+ * moved on and the feeder is saved. The feeders next feed is then scheduled.
+ *
+ * @param context The feeder being fed.
+ */
+static void feedWork(void *context) {
+    feederInstanceStruct *feeder = context;
+    operatingModeStruct *operatingMode = &feeder->operatingMode;
+    pthread_mutex_lock(&feeder->lock);
+    if (operatingMode->mode != 0 || operatingMode->numberOfFeedsInADay == 0) {
+        //The feeder was paused or its schedule removed after the feed was scheduled.
+        pthread_mutex_unlock(&feeder->lock);
+        return;
+    }
+    const timeStruct feedTime = operatingMode->feedTimes[operatingMode->nextFeed];
+    incrementNumber(&operatingMode->autoFeedsDone, 999, 1);
+    pthread_mutex_unlock(&feeder->lock);
+
+    const int totalSteps = feedTime.rotations * STEPS_PER_ROTATION;
+    long long stepDueUs = monotonicUs();
+    for (int i = 0; i < totalSteps && hostRunning(feeder->host); i++) {
+        pthread_mutex_lock(&feeder->lock);
+        backendMotorStep(&feeder->backend);
+        pthread_mutex_unlock(&feeder->lock);
+        //Paced against absolute deadlines at the same speed as the GUI feeders motor, so lateness doesn't build up.
+        if (i + 1 < totalSteps) {
+            stepDueUs += motorStepIntervalUs(&feedProfile, i + 1, totalSteps);
+            sleepUntilUs(stepDueUs);
+        }
+    }
+
+    pthread_mutex_lock(&feeder->lock);
+    backendFoodFill(&feeder->backend, 50); //Refills the feeder after a feed.
+    incrementNumber(&operatingMode->nextFeed, operatingMode->numberOfFeedsInADay - 1, 0);
+    saveFeeder(feeder);
+    pthread_mutex_unlock(&feeder->lock);
+    scheduleNextFeed(feeder);
+}
+
+/**
+ * Called by the scheduler thread when a feeders next feed is due, the feed is handed to a worker. If the work queue is
+ * full the feed is tried again shortly, so the feeder never stops feeding. The wheel lock is held.
+ *
+ * @param timer The feeders feed timer.
+ * @param context The feeder whose feed is due.
+ */
+static void feedDue(timerStruct *timer, void *context) {
+    feederInstanceStruct *feeder = context;
+    if (!hostSubmitWork(feeder->host, feedWork, feeder)) {
+        printf("Feeder %d: work queue full, feed retried in %ldms\n", feeder->id, FEED_RETRY_MS);
+        timerWheelAdd(&feeder->host->wheel, timer, FEED_RETRY_MS);
+    }
+}
+
+/**
+ * Arms the feeders timer so it fires at the start of the minute of its next feed, using the feeders own clock.
+ * If the feeder is paused or has no schedule the timer is cancelled.
+ *
+ * @param feeder The feeder to be scheduled.
+ */
+void scheduleNextFeed(feederInstanceStruct *feeder) {
+    const operatingModeStruct *operatingMode = &feeder->operatingMode;
+    long delayMs = -1;
+    pthread_mutex_lock(&feeder->lock);
+    if (operatingMode->mode == 0 && operatingMode->numberOfFeedsInADay > 0) {
+        struct tm now;
+        backendClockNow(&feeder->backend, &now);
+        const timeStruct feedTime = operatingMode->feedTimes[operatingMode->nextFeed];
+        const long secondOfDay = now.tm_hour * 3600L + now.tm_min * 60L + now.tm_sec;
+        const long feedSecond = feedTime.hour * 3600L + feedTime.minute * 60L;
+        delayMs = ((feedSecond - secondOfDay + SECONDS_IN_DAY) % SECONDS_IN_DAY) * 1000L;
+    }
+    pthread_mutex_unlock(&feeder->lock);
+
+    pthread_mutex_lock(&feeder->host->wheelLock);
+    if (delayMs >= 0) {
+        timerWheelAdd(&feeder->host->wheel, &feeder->feedTimer, delayMs);
+        pthread_cond_signal(&feeder->host->wheelChanged); //The scheduler may need to wake sooner.
+    } else {
+        timerWheelCancel(&feeder->host->wheel, &feeder->feedTimer);
+    }
+    pthread_mutex_unlock(&feeder->host->wheelLock);
+}
+
+/**
+ * Loads a feeder from its save file, the warm start value in the file is used as the feeders clock offset.
+ *
+ * @param feeder The feeder to be loaded.
+ * @param id The feeders number.
+ * @param host The host the feeder belongs to.
+ */
+static void loadFeeder(feederInstanceStruct *feeder, const int id, feederHostStruct *host) {
+    long long rtcOffsetSeconds;
+    feeder->id = id;
+    feeder->host = host;
+    snprintf(feeder->eepromFilename, FILENAME_BUFFER, "fakeEEPROM_%d.txt", id);
+    readEEPROMFile(feeder->eepromFilename, &feeder->operatingMode, &rtcOffsetSeconds);
+    if (feeder->operatingMode.numberOfFeedsInADay < 0 || feeder->operatingMode.numberOfFeedsInADay > 9) {
+        //A corrupt file is treated like a missing one.
+        feeder->operatingMode.numberOfFeedsInADay = 0;
+        feeder->operatingMode.mode = 1;
+    }
+    initialiseFeederBackend(&feeder->backend, rtcOffsetSeconds);
+    initialiseTimer(&feeder->feedTimer, feedDue, feeder);
+    pthread_mutex_init(&feeder->lock, NULL);
+    struct tm now;
+    backendClockNow(&feeder->backend, &now);
+    findNextFeedAt(&feeder->operatingMode, now.tm_hour * 60 + now.tm_min);
+}
+
+/**
+ * Starts the scheduler and worker threads and schedules the first feed of every feeder.
+ *
+ * @param host The host to be started.
+ * @param feeders The feeders, they should already be loaded.
+ * @param numberOfFeeders How many feeders there are.
+ */
+void startFeederHost(feederHostStruct *host, feederInstanceStruct *feeders, const int numberOfFeeders) {
+    host->feeders = feeders;
+    host->numberOfFeeders = numberOfFeeders;
+    host->running = true;
+    host->workHead = 0;
+    host->workCount = 0;
+    initialiseTimerWheel(&host->wheel);
+    pthread_mutex_init(&host->wheelLock, NULL);
+    pthread_cond_init(&host->wheelChanged, NULL);
+    pthread_mutex_init(&host->workLock, NULL);
+    pthread_cond_init(&host->workAvailable, NULL);
+    for (int i = 0; i < FEEDER_WORKERS; i++) {
+        pthread_create(&host->workers[i], NULL, workerThread, host);
+    }
+    pthread_create(&host->scheduler, NULL, schedulerThread, host);
+    for (int i = 0; i < numberOfFeeders; i++) {
+        scheduleNextFeed(&feeders[i]);
+    }
+}
+
+/**
+ * Stops the scheduler and worker threads, any feed in progress is stopped early, then every feeder is saved.
+ *
+ * @param host The host to be stopped.
+ */
+void stopFeederHost(feederHostStruct *host) {
+    pthread_mutex_lock(&host->wheelLock);
+    pthread_mutex_lock(&host->workLock);
+    host->running = false;
+    pthread_cond_broadcast(&host->workAvailable);
+    pthread_mutex_unlock(&host->workLock);
+    pthread_cond_broadcast(&host->wheelChanged);
+    pthread_mutex_unlock(&host->wheelLock);
+    pthread_join(host->scheduler, NULL);
+    for (int i = 0; i < FEEDER_WORKERS; i++) {
+        pthread_join(host->workers[i], NULL);
+    }
+    for (int i = 0; i < host->numberOfFeeders; i++) {
+        pthread_mutex_lock(&host->feeders[i].lock);
+        saveFeeder(&host->feeders[i]);
+        pthread_mutex_unlock(&host->feeders[i].lock);
+    }
+}
+
+/**
+ * The entry point of the multi-feeder mode. The feeders are loaded from 'fakeEEPROM_<number>.txt' files and fed on
+ * their schedules until the process is interrupted, they are then saved.
+ * No GUI is used so the JVM is never started.
+ *
+ * @param numberOfFeeders How many feeders to host.
+ * @return "EXIT_SUCCESS" or "EXIT_FAILURE" if the number of feeders isn't valid.
+ */
+int runMultiFeeder(const int numberOfFeeders) {
+    if (numberOfFeeders < 1 || numberOfFeeders > MAX_FEEDERS) {
+        printf("Number of feeders must be between 1 and %d\n", MAX_FEEDERS);
+        return EXIT_FAILURE;
+    }
+    static feederHostStruct host; //Too large to be on the stack.
+    feederInstanceStruct *feeders = calloc((size_t) numberOfFeeders, sizeof(feederInstanceStruct));
+    for (int i = 0; i < numberOfFeeders; i++) {
+        loadFeeder(&feeders[i], i, &host);
+    }
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    startFeederHost(&host, feeders, numberOfFeeders);
+    printf("Hosting %d feeders, interrupt to save and exit\n", numberOfFeeders);
+    while (!stopRequested) {
+        msleep(200L);
+    }
+    stopFeederHost(&host);
+    for (int i = 0; i < numberOfFeeders; i++) {
+        pthread_mutex_destroy(&feeders[i].lock);
+    }
+    free(feeders);
+    return EXIT_SUCCESS;
+}
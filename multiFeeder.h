@@ -0,0 +1,74 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the multi-feeder mode, where many headless feeders are hosted by one process.
+*
+* Every feeder has its own operating mode, clock offset, save file and backend. The feeders share one scheduler thread,
+* which runs a timer wheel holding each feeders next feed, and a pool of worker threads that do the motor work.
+*/
+#ifndef MULTI_FEEDER_HEADER
+#define MULTI_FEEDER_HEADER
+#include <pthread.h>
+#include <stdbool.h>
+#include "feederBackend.h"
+#include "operatingMode.h"
+#include "timerWheel.h"
+
+#define MAX_FEEDERS 256
+#define FEEDER_WORKERS 4
+#define WORK_QUEUE_SIZE MAX_FEEDERS
+#define FILENAME_BUFFER 64
+#define FEED_RETRY_MS 1000L //How long a feed waits for space in a full work queue before it is tried again.
+
+typedef struct feederHostStruct feederHostStruct;
+
+/**
+ * One feeder hosted in the process.
+ */
+typedef struct {
+    int id; //The feeders number, used for its save file name.
+    char eepromFilename[FILENAME_BUFFER]; //The feeders save file.
+    operatingModeStruct operatingMode; //The feeders schedule and mode.
+    feederBackendStruct backend; //The feeders hardware.
+    timerStruct feedTimer; //Fires when the feeders next feed is due.
+    pthread_mutex_t lock; //Guards the operating mode and backend.
+    feederHostStruct *host; //The host the feeder belongs to.
+} feederInstanceStruct;
+
+typedef void (*workFunction)(void *context); //Work done by one of the worker threads.
+
+/**
+ * An item of work waiting in the work queue.
+ */
+typedef struct {
+    workFunction function;
+    void *context;
+} workItemStruct;
+
+/**
+ * The host of the feeders, it owns the shared scheduler and worker threads.
+ */
+struct feederHostStruct {
+    feederInstanceStruct *feeders; //The hosted feeders.
+    int numberOfFeeders;
+    bool running; //Set to false to stop the scheduler and workers, only changed holding both locks.
+
+    timerWheelStruct wheel; //Holds the next feed of every feeder.
+    pthread_mutex_t wheelLock; //Guards the wheel.
+    pthread_cond_t wheelChanged; //Signalled when a timer is added so the scheduler can recalculate its wait.
+    pthread_t scheduler;
+
+    workItemStruct workQueue[WORK_QUEUE_SIZE]; //A ring buffer of work waiting for a worker.
+    int workHead; //The index of the oldest work item.
+    int workCount; //How many work items are waiting.
+    pthread_mutex_t workLock; //Guards the work queue.
+    pthread_cond_t workAvailable; //Signalled when work is added.
+    pthread_t workers[FEEDER_WORKERS];
+};
+
+bool hostSubmitWork(feederHostStruct *host, workFunction function, void *context); //Queues work for the workers.
+void scheduleNextFeed(feederInstanceStruct *feeder); //Arms the feeders timer for its next feed.
+void startFeederHost(feederHostStruct *host, feederInstanceStruct *feeders, const int numberOfFeeders);
+void stopFeederHost(feederHostStruct *host); //Stops the threads and saves every feeder.
+int runMultiFeeder(const int numberOfFeeders); //Entry point for the multi-feeder mode.
+#endif //MULTI_FEEDER_HEADER
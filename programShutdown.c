@@ -4,27 +4,58 @@
 * This function mimics saving to EEPROM.
 */
 #include <stdio.h>
-#include "fish.h"
+#include <unistd.h>
+#include "clockOffset.h"
+#include "eepromImage.h"
 #include "programShutdown.h"
+#define FILENAME_BUFFER 256
 /**
- * This function saves the operating mode in a file.
- * This allows the program to be set up in the same way when it starts up again.
+ * This function writes the operating mode and a clock value to a file in the format loadFromEEPROM reads.
+ * The information is written to a temporary file which is synced to disk and then renamed over the file, so if the
+ * program is killed part way through the old file is left whole.
  *
  * @param filename The name of the file that is to be saved to.
  * @param operatingMode The operating mode that the information is got from.
+ * @param warmStartValue The value that lets the clock be restored when the file is read.
+ * @return If the file was saved.
  */
-void saveToEEPROM(const char *filename, const operatingModeStruct *operatingMode) {
-    FILE *file = fopen(filename, "w");
+bool writeEEPROMFile(const char *filename, const operatingModeStruct *operatingMode, const long long warmStartValue) {
+    char temporaryFilename[FILENAME_BUFFER];
+    snprintf(temporaryFilename, FILENAME_BUFFER, "%s.tmp", filename);
+    FILE *file = fopen(temporaryFilename, "w");
     if (file == NULL) {
         //If the file can't be written to
         printf("Error opening file\n");
-    } else {
-        fprintf(file, "%lld %d %d %d %d", clockWarmStart(0), operatingMode->mode, operatingMode->numberOfFeedsInADay,
-                operatingMode->autoFeedsDone, operatingMode->nextFeed);
-        for (int i = 0; i < operatingMode->numberOfFeedsInADay; i++) {
-            fprintf(file, " %d %d %d", operatingMode->feedTimes[i].rotations, operatingMode->feedTimes[i].hour,
-                    operatingMode->feedTimes[i].minute);
-        }
-        fclose(file); //Close the file.
+        return false;
+    }
+    fprintf(file, "%lld %d %d %d %d", warmStartValue, operatingMode->mode, operatingMode->numberOfFeedsInADay,
+            operatingMode->autoFeedsDone, operatingMode->nextFeed);
+    for (int i = 0; i < operatingMode->numberOfFeedsInADay; i++) {
+        fprintf(file, " %d %d %d", operatingMode->feedTimes[i].rotations, operatingMode->feedTimes[i].hour,
+                operatingMode->feedTimes[i].minute);
+    }
+    //The contents must be on disk before the rename makes them the saved file.
+    const bool written = fflush(file) == 0 && fsync(fileno(file)) == 0;
+    fclose(file); //Close the file.
+    if (!written || rename(temporaryFilename, filename) != 0) {
+        printf("Error saving file\n");
+        remove(temporaryFilename);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * This function saves the operating mode in the EEPROM image, only the fields that have changed are written.
+ * This allows the program to be set up in the same way when it starts up again.
+ *
+ * @param filename The name of the EEPROM image, used if the image isn't already open.
+ * @param operatingMode The operating mode that the information is got from.
+ * @return If the image was written to disk.
+ */
+bool saveToEEPROM(const char *filename, const operatingModeStruct *operatingMode) {
+    if (!eepromImageIsOpen(&programEEPROM) && !openEEPROMImage(&programEEPROM, filename)) {
+        return false;
     }
+    return eepromImageStore(&programEEPROM, operatingMode, clockOffset());
 }
@@ -5,6 +5,8 @@
 */
 #ifndef PROGRAM_SHUTDOWN_HEADER
 #define PROGRAM_SHUTDOWN_HEADER
+#include <stdbool.h>
 #include "operatingMode.h"
-void saveToEEPROM(const char *filename, const operatingModeStruct *operatingMode); //Saves info to file.
+bool saveToEEPROM(const char *filename, const operatingModeStruct *operatingMode); //Saves info to the EEPROM image.
+bool writeEEPROMFile(const char *filename, const operatingModeStruct *operatingMode, const long long warmStartValue);
 #endif //PROGRAM_SHUTDOWN_HEADER
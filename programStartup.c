@@ -5,8 +5,13 @@
 */
 #include <stddef.h>
 #include <stdio.h>
+#include "clockOffset.h"
+#include "eepromImage.h"
+#include "eepromJournal.h"
 #include "fish.h"
 #include "operatingMode.h"
+#include "programStartup.h"
+#define TEXT_EEPROM_FILENAME "fakeEEPROM.txt"
 
 /**
  * This function uses the warmStart value to start up the clock to the same time it was when the program last exited.
@@ -23,17 +28,21 @@ void initialiseProgram(const long warmStart) {
     } else {
         clockWarmStart(warmStart);
     }
+    clockOffsetChanged();
     foodFill(50); // Fill the food container.
 }
 
 /**
- * This function attempts to read from the file given and saves the information from it to the operating mode.
- * This allows the program to be set up the exact same as when it was last closed.
+ * This function attempts to read the file given and saves the information from it to the operating mode.
+ * Unlike loadFromEEPROM it doesn't touch the hardware, so it can be used for feeders that aren't shown on the GUI.
+ * If the file cannot be read the operating mode is left as a generic operating mode with no feeds.
  *
  * @param filename The name of the file that is to be read.
  * @param operatingMode The operating mode that the read information is saved to.
+ * @param warmStartValue Set to the clock value saved in the file, or 0 if the file cannot be read.
+ * @return If the file was read.
  */
-void loadFromEEPROM(const char *filename, operatingModeStruct *operatingMode) {
+bool readEEPROMFile(const char *filename, operatingModeStruct *operatingMode, long long *warmStartValue) {
     FILE *file = fopen(filename, "r");
     timeStruct time;
     initialiseTime(&time, 0, 0, 0);
@@ -41,19 +50,88 @@ void loadFromEEPROM(const char *filename, operatingModeStruct *operatingMode) {
     timeStruct emptyFeeds[9] = {time, time, time, time, time, time, time, time, time};
     //A generic version of the operating mode with no feeds is initialised so if the file cannot be read then the program will still run smoothly.
     initialiseOperatingMode(operatingMode, 1, -1, 0, emptyFeeds, 0);
-    //If there is a file to read from then gets the information from that to set time and what operating mode it is on.
-    long long warmStartValue = 0; //Generic value in case the file cannot be read.
-    if (file != NULL) {
-        //If the file can be read.
-        fscanf(file, "%lld %d %d %d %d", &warmStartValue, &operatingMode->mode, &operatingMode->numberOfFeedsInADay,
-               &operatingMode->autoFeedsDone, &operatingMode->nextFeed);
-        for (int i = 0; i < operatingMode->numberOfFeedsInADay; i++) {
-            fscanf(file, " %d %d %d", &time.rotations, &time.hour, &time.minute);
-            operatingMode->feedTimes[i] = time;
-        }
-        fclose(file); //Close the file.
-        initialiseProgram(warmStartValue); //Finishes the program startup.
-    } else {
-        initialiseProgram(warmStartValue); //Finishes the program startup.
+    *warmStartValue = 0; //Generic value in case the file cannot be read.
+    if (file == NULL) {
+        return false;
+    }
+    //If the file can be read.
+    fscanf(file, "%lld %d %d %d %d", warmStartValue, &operatingMode->mode, &operatingMode->numberOfFeedsInADay,
+           &operatingMode->autoFeedsDone, &operatingMode->nextFeed);
+    //A corrupt count would overflow feedTimes, so the count and next feed are kept in range.
+    if (operatingMode->numberOfFeedsInADay < 0 || operatingMode->numberOfFeedsInADay > 9) {
+        operatingMode->numberOfFeedsInADay = 0;
+    }
+    if (operatingMode->nextFeed < -1 || operatingMode->nextFeed >= operatingMode->numberOfFeedsInADay) {
+        operatingMode->nextFeed = operatingMode->numberOfFeedsInADay > 0 ? 0 : -1;
+    }
+    for (int i = 0; i < operatingMode->numberOfFeedsInADay; i++) {
+        fscanf(file, " %d %d %d", &time.rotations, &time.hour, &time.minute);
+        operatingMode->feedTimes[i] = time;
+    }
+    fclose(file); //Close the file.
+    return true;
+}
+
+/**
+ * This function moves the text save file used before the EEPROM image, and any journal that went with it, into the
+ * image. Once the image holds them on disk both files are deleted so they can never be read again.
+ *
+ * @param operatingMode The operating mode that the read information is saved to.
+ * @param warmStartValue Set to the clock value saved in the file, or 0 if the file cannot be read.
+ */
+static void moveTextEEPROM(operatingModeStruct *operatingMode, long long *warmStartValue) {
+    char journalFilename[JOURNAL_FILENAME_BUFFER];
+    bool read = readEEPROMFile(TEXT_EEPROM_FILENAME, operatingMode, warmStartValue);
+    journalFilenameFor(TEXT_EEPROM_FILENAME, journalFilename);
+    read |= replayJournal(journalFilename, operatingMode, warmStartValue) > 0;
+    if (read && eepromImageStore(&programEEPROM, operatingMode, *warmStartValue)) {
+        printf("Moved %s into the EEPROM image\n", TEXT_EEPROM_FILENAME);
+        remove(TEXT_EEPROM_FILENAME);
+        remove(journalFilename);
+    }
+}
+
+/**
+ * This function attempts to read from the EEPROM image given and saves the information from it to the operating mode.
+ * Any changes in the images journal are then replayed, so the program is set up the exact same as it was last left even
+ * if it didn't exit properly. Unlike loadFromEEPROM it doesn't touch the hardware, so it can run on another thread
+ * while the GUI starts.
+ *
+ * If the image is blank the old text save file is moved into it. A corrupt image is never loaded, the program starts
+ * with a generic operating mode instead.
+ *
+ * @param filename The name of the EEPROM image that is to be read.
+ * @param operatingMode The operating mode that the read information is saved to.
+ * @param warmStartValue Set to the clock value that was saved, or 0 if there isn't one.
+ */
+void readEEPROMImage(const char *filename, operatingModeStruct *operatingMode, long long *warmStartValue) {
+    if (!eepromImageIsOpen(&programEEPROM)) {
+        openEEPROMImage(&programEEPROM, filename);
+    }
+    //If there is a valid image then gets the information from that to set time and what operating mode it is on.
+    if (!eepromImageLoad(&programEEPROM, operatingMode, warmStartValue)) {
+        printf("The EEPROM image is corrupt\n");
+        timeStruct time;
+        initialiseTime(&time, 0, 0, 0);
+        timeStruct emptyFeeds[9] = {time, time, time, time, time, time, time, time, time};
+        initialiseOperatingMode(operatingMode, 1, -1, 0, emptyFeeds, 0);
+        *warmStartValue = 0;
+    } else if (eepromImageIsBlank(&programEEPROM)) {
+        moveTextEEPROM(operatingMode, warmStartValue); //The image has never been saved to.
     }
+    char journalFilename[JOURNAL_FILENAME_BUFFER];
+    journalFilenameFor(filename, journalFilename);
+    replayJournal(journalFilename, operatingMode, warmStartValue);
+}
+
+/**
+ * This function reads the EEPROM image given and its journal, then starts the program up with what was read.
+ *
+ * @param filename The name of the EEPROM image that is to be read.
+ * @param operatingMode The operating mode that the read information is saved to.
+ */
+void loadFromEEPROM(const char *filename, operatingModeStruct *operatingMode) {
+    long long warmStartValue;
+    readEEPROMImage(filename, operatingMode, &warmStartValue);
+    initialiseProgram(warmStartValue); //Finishes the program startup.
 }
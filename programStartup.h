@@ -6,6 +6,10 @@
 
 #ifndef PROGRAM_STARTUP_HEADER
 #define PROGRAM_STARTUP_HEADER
+#include <stdbool.h>
+#include "operatingMode.h"
 void initialiseProgram(const long warmStart); //Sets the time up and fills the fish feeder.
 void loadFromEEPROM(const char *filename,operatingModeStruct *operatingMode); //Sets the operating mode up.
+void readEEPROMImage(const char *filename, operatingModeStruct *operatingMode, long long *warmStartValue); //No hardware.
+bool readEEPROMFile(const char *filename, operatingModeStruct *operatingMode, long long *warmStartValue); //Reads the file only.
 #endif //PROGRAM_STARTUP_HEADER
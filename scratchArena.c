@@ -0,0 +1,53 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* Scratch arenas, memory for short lived text that is reset once a call is finished.
+*/
+#include <stdarg.h>
+#include <stdio.h>
+#include "scratchArena.h"
+
+static _Thread_local scratchArenaStruct threadArena; //Zeroed, so it starts empty.
+
+/**
+ * @return The arena of the calling thread, each thread has its own so no lock is needed.
+ */
+scratchArenaStruct *scratchArena() {
+    return &threadArena;
+}
+
+/**
+ * Formats text into the arena like printf, the text lasts until the arena is reset.
+ *
+ * @param arena The arena.
+ * @param format The printf format.
+ * @param ... The values to be formatted.
+ * @return The text, cut short if the arena is nearly full or an empty string if it is full.
+ */
+char *scratchFormat(scratchArenaStruct *arena, const char *format, ...) {
+    if (arena->used >= SCRATCH_ARENA_SIZE) {
+        return arena->buffer + SCRATCH_ARENA_SIZE;
+    }
+    char *text = arena->buffer + arena->used;
+    const size_t available = SCRATCH_ARENA_SIZE - arena->used;
+    va_list values;
+    va_start(values, format);
+    const int length = vsnprintf(text, available, format, values);
+    va_end(values);
+    if (length < 0) {
+        text[0] = '\0';
+        arena->used++;
+    } else {
+        arena->used += (size_t) length < available ? (size_t) length + 1 : available;
+    }
+    return text;
+}
+
+/**
+ * Gives back everything taken from the arena, anything taken before must not be used after this.
+ *
+ * @param arena The arena.
+ */
+void scratchReset(scratchArenaStruct *arena) {
+    arena->used = 0;
+}
@@ -0,0 +1,27 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides scratch arenas, a fixed block of memory per thread that short lived text is formatted into.
+*
+* Memory is taken from the arena by moving a pointer along it, nothing is freed on its own. The whole arena is reset
+* in one go once the call that used it is finished, so formatting a number or copying a result costs no malloc or free
+* and the memory a thread uses never grows no matter how long the program runs.
+*/
+#ifndef SCRATCH_ARENA_HEADER
+#define SCRATCH_ARENA_HEADER
+#include <stddef.h>
+
+#define SCRATCH_ARENA_SIZE 4096
+
+/**
+ * A scratch arena, the last byte of the buffer is always the end of an empty string.
+ */
+typedef struct {
+    char buffer[SCRATCH_ARENA_SIZE + 1];
+    size_t used;
+} scratchArenaStruct;
+
+scratchArenaStruct *scratchArena(); //The arena of the calling thread.
+char *scratchFormat(scratchArenaStruct *arena, const char *format, ...);
+void scratchReset(scratchArenaStruct *arena);
+#endif //SCRATCH_ARENA_HEADER
@@ -0,0 +1,77 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* Screen templates, the part of a screen that is built once and shown again without being worked out.
+*/
+#include <stdio.h>
+#include "screenTemplate.h"
+
+/**
+ * Starts an empty template.
+ *
+ * @param screenTemplate The template to be initialised.
+ * @param name The screen it is for.
+ * @param variant Tells apart templates for the same screen.
+ */
+void initialiseScreenTemplate(screenTemplateStruct *screenTemplate, const char *name, const int variant) {
+    snprintf(screenTemplate->name, TEMPLATE_TEXT_BUFFER, "%s", name);
+    screenTemplate->variant = variant;
+    screenTemplate->numberOfItems = 0;
+    framebufferClear(&screenTemplate->layer);
+}
+
+/**
+ * Adds an item to a template.
+ *
+ * @param screenTemplate The template.
+ * @return The item to be filled in, NULL if the template is full.
+ */
+static templateItemStruct *addItem(screenTemplateStruct *screenTemplate) {
+    if (screenTemplate->numberOfItems == TEMPLATE_MAX_ITEMS) {
+        printf("The %s template is full\n", screenTemplate->name);
+        return NULL;
+    }
+    return &screenTemplate->items[screenTemplate->numberOfItems++];
+}
+
+/**
+ * Adds text to a template and draws it into the template's layer in the display's font.
+ *
+ * @param screenTemplate The template.
+ * @param x The left of the text.
+ * @param y The top of the text.
+ * @param text The text, it is copied.
+ * @param size 1 or 2.
+ */
+void templateText(screenTemplateStruct *screenTemplate, const int x, const int y, const char *text, const int size) {
+    templateItemStruct *item = addItem(screenTemplate);
+    if (item != NULL) {
+        item->kind = TEMPLATE_TEXT;
+        item->x = x;
+        item->y = y;
+        item->size = size;
+        snprintf(item->text, TEMPLATE_TEXT_BUFFER, "%s", text);
+        framebufferText(&screenTemplate->layer, x, y, item->text, size);
+    }
+}
+
+/**
+ * Adds a line to a template and draws it into the template's layer.
+ *
+ * @param screenTemplate The template.
+ * @param x The start column.
+ * @param y The start row.
+ * @param x1 The end column.
+ * @param y1 The end row.
+ */
+void templateLine(screenTemplateStruct *screenTemplate, const int x, const int y, const int x1, const int y1) {
+    templateItemStruct *item = addItem(screenTemplate);
+    if (item != NULL) {
+        item->kind = TEMPLATE_LINE;
+        item->x = x;
+        item->y = y;
+        item->x1 = x1;
+        item->y1 = y1;
+        framebufferLine(&screenTemplate->layer, x, y, x1, y1, true);
+    }
+}
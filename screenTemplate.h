@@ -0,0 +1,53 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides screen templates, the part of a screen that is the same every time it is shown.
+*
+* A template is built once, its text, lines and rectangles are drawn into its own framebuffer layer and are kept as a
+* list of what to send. Showing a template copies the layer into the graphics state's framebuffer and
+* sends the list, nothing about it is worked out again. While a template is showing, a screen using it only has to
+* redraw the parts of it that change.
+*/
+#ifndef SCREEN_TEMPLATE_HEADER
+#define SCREEN_TEMPLATE_HEADER
+#include "framebuffer.h"
+
+#define TEMPLATE_MAX_ITEMS 32
+#define TEMPLATE_TEXT_BUFFER 22
+
+/**
+ * What a template item is.
+ */
+typedef enum {
+    TEMPLATE_TEXT,
+    TEMPLATE_LINE
+} templateItemKind;
+
+/**
+ * Something drawn by a template.
+ */
+typedef struct {
+    templateItemKind kind;
+    int x;
+    int y;
+    int x1; //The end of a line.
+    int y1;
+    int size; //The size of text.
+    char text[TEMPLATE_TEXT_BUFFER];
+} templateItemStruct;
+
+/**
+ * A template, a template is drawn in the default colours on a cleared display.
+ */
+typedef struct {
+    char name[TEMPLATE_TEXT_BUFFER]; //The screen it is for.
+    int variant; //Tells apart templates for the same screen, such as how many digits it shows.
+    int numberOfItems;
+    templateItemStruct items[TEMPLATE_MAX_ITEMS];
+    framebufferStruct layer; //The text and lines of the template, already drawn.
+} screenTemplateStruct;
+
+void initialiseScreenTemplate(screenTemplateStruct *screenTemplate, const char *name, const int variant);
+void templateText(screenTemplateStruct *screenTemplate, const int x, const int y, const char *text, const int size);
+void templateLine(screenTemplateStruct *screenTemplate, const int x, const int y, const int x1, const int y1);
+#endif //SCREEN_TEMPLATE_HEADER
@@ -7,5 +7,5 @@
 #define SPLASH_SCREEN_PT2_HEADER
 #include <stdint.h>
 // Declares the image arrays
-const uint8_t splashScreenPt2[64][128][3];
+extern const uint8_t splashScreenPt2[64][128][3];
 #endif // SPLASH_SCREEN_PT2_HEADER
@@ -7,5 +7,5 @@
 #define SPLASH_SCREEN_PT3_HEADER
 
 // Declares the image arrays
-const uint8_t splashScreenPt3[64][128][3];
+extern const uint8_t splashScreenPt3[64][128][3];
 #endif // SPLASH_SCREEN_PT3_HEADER
\ No newline at end of file
@@ -7,6 +7,6 @@
 #define SPLASH_SCREEN_PT4_HEADER
 
 // Declares the image arrays
-const uint8_t splashScreenPt4[64][128][3];
+extern const uint8_t splashScreenPt4[64][128][3];
 
 #endif // SPLASH_SCREEN_PT4_HEADER
\ No newline at end of file
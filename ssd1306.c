@@ -0,0 +1,79 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The model of the SSD1306 display controller, its page organised display memory and the transfer of dirty pages.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+
+#define SSD1306_PAGE_BYTES (SSD1306_PAGE_COMMAND_BYTES + SSD1306_WIDTH) //What sending one page costs.
+
+ssd1306Struct programSsd1306;
+
+/**
+ * Clears the display memory. What the display shows before the first transfer isn't known, so every page is dirty.
+ *
+ * @param controller The controller.
+ */
+void initialiseSsd1306(ssd1306Struct *controller) {
+    memset(controller, 0, sizeof(ssd1306Struct));
+    controller->dirtyPages = SSD1306_ALL_PAGES;
+}
+
+/**
+ * Packs a frame into the display memory, a page is only marked dirty if its bytes changed.
+ *
+ * @param controller The controller.
+ * @param framebuffer The frame.
+ */
+void ssd1306Load(ssd1306Struct *controller, const framebufferStruct *framebuffer) {
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        uint8_t packed[SSD1306_WIDTH] = {0};
+        for (int row = 0; row < SSD1306_PAGE_ROWS; row++) {
+            const uint32_t *words = framebuffer->rows[page * SSD1306_PAGE_ROWS + row];
+            for (int word = 0; word < FRAMEBUFFER_ROW_WORDS; word++) {
+                //Only the set pixels are visited, most of a row is background.
+                for (uint32_t bits = words[word]; bits != 0; bits &= bits - 1) {
+                    packed[word * FRAMEBUFFER_WORD_BITS + __builtin_ctz(bits)] |= (uint8_t) (1 << row);
+                }
+            }
+        }
+        if (memcmp(controller->pages[page], packed, SSD1306_WIDTH) != 0) {
+            memcpy(controller->pages[page], packed, SSD1306_WIDTH);
+            controller->dirtyPages |= (uint8_t) (1 << page);
+        }
+    }
+}
+
+/**
+ * Sends every dirty page to the display, a page is the commands that address it and then its bytes.
+ *
+ * @param controller The controller.
+ * @return How many bytes were sent.
+ */
+int ssd1306Transfer(ssd1306Struct *controller) {
+    int bytes = 0;
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        if (controller->dirtyPages & (1 << page)) {
+            controller->pagesTransferred++;
+            bytes += SSD1306_PAGE_BYTES;
+        }
+    }
+    controller->dirtyPages = 0;
+    controller->transfers++;
+    controller->bytesTransferred += bytes;
+    return bytes;
+}
+
+/**
+ * Prints how many pages and bytes have been transferred, against sending the whole display memory every frame.
+ *
+ * @param controller The controller.
+ */
+void ssd1306Report(const ssd1306Struct *controller) {
+    const long long fullBytes = controller->transfers * SSD1306_PAGES * SSD1306_PAGE_BYTES;
+    printf("SSD1306 transfers: %lld frames, %lld of %lld pages, %lld bytes, %.1f%% of sending every page\n",
+           controller->transfers, controller->pagesTransferred, controller->transfers * SSD1306_PAGES,
+           controller->bytesTransferred, fullBytes > 0 ? 100.0 * controller->bytesTransferred / fullBytes : 0);
+}
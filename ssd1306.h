@@ -0,0 +1,43 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides a model of the SSD1306, the controller of the feeder's 128x64 monochrome OLED display.
+*
+* The controller's display memory is 1KB split into 8 pages, a page is a band of 8 rows and holds one byte for each
+* column, bit n of the byte is the pixel n rows into the page. The framebuffer keeps its pixels in rows, so a frame is
+* packed into pages when it is loaded, and only a page whose bytes changed is marked dirty. Text is in the framebuffer
+* as the glyphs of the display's font, so the pages hold everything the real display would show.
+*
+* A transfer sends every dirty page the way the controller takes them in page addressing mode, the three commands
+* that set the page and the column to 0 and then the 128 bytes of the page, and counts the bytes so what a frame would
+* cost on the real display's bus is known.
+*/
+#ifndef SSD1306_HEADER
+#define SSD1306_HEADER
+#include <stdint.h>
+#include "framebuffer.h"
+
+#define SSD1306_WIDTH FRAMEBUFFER_WIDTH
+#define SSD1306_PAGE_ROWS 8
+#define SSD1306_PAGES (FRAMEBUFFER_HEIGHT / SSD1306_PAGE_ROWS)
+#define SSD1306_ALL_PAGES ((uint8_t) ((1 << SSD1306_PAGES) - 1))
+#define SSD1306_PAGE_COMMAND_BYTES 3 //Set the page, set the low and high nibbles of the column.
+
+/**
+ * The controller's display memory, what the display shows.
+ */
+typedef struct {
+    uint8_t pages[SSD1306_PAGES][SSD1306_WIDTH];
+    uint8_t dirtyPages; //Bit n is set if page n has changed since it was last transferred.
+    long long transfers; //How many frames have been transferred.
+    long long pagesTransferred;
+    long long bytesTransferred; //Commands and pages.
+} ssd1306Struct;
+
+extern ssd1306Struct programSsd1306; //The display's controller.
+
+void initialiseSsd1306(ssd1306Struct *controller);
+void ssd1306Load(ssd1306Struct *controller, const framebufferStruct *framebuffer); //Packs a frame into the pages.
+int ssd1306Transfer(ssd1306Struct *controller); //Sends the dirty pages.
+void ssd1306Report(const ssd1306Struct *controller);
+#endif //SSD1306_HEADER
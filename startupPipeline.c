@@ -0,0 +1,177 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The startup pipeline, the phases of starting up run on their own threads and signal the processing thread when done.
+*/
+#include <stdio.h>
+#include <time.h>
+#include "displayScreens.h"
+#include "feedHistory.h"
+#include "menusFunctions.h"
+#include "programStartup.h"
+#include "startupPipeline.h"
+#include "timerWheel.h"
+
+//The lock is ready before the startup is started, so the phases can be marked even by programs that don't start it.
+startupStruct programStartup = {.lock = PTHREAD_MUTEX_INITIALIZER, .phaseDone = PTHREAD_COND_INITIALIZER};
+
+/**
+ * Works out the time of day the clock will show once it is started from a warm start value, the same way the clock
+ * does. A warm start value is the clocks offset from real time.
+ *
+ * @param warmStartValue The saved clock value, 0 if there isn't one.
+ * @return The time of day in minutes.
+ */
+static int warmStartMinuteOfDay(const long long warmStartValue) {
+    if (warmStartValue == 0) {
+        return 14 * 60; //initialiseProgram starts the clock at 14:00.
+    }
+    const time_t feederTime = time(NULL) + (time_t) warmStartValue;
+    struct tm clockTime;
+    localtime_r(&feederTime, &clockTime);
+    return clockTime.tm_hour * 60 + clockTime.tm_min;
+}
+
+/**
+ * The splash phase, decodes the splash screen so the first frame can be drawn as soon as the GUI is ready, then builds
+ * the screen templates so no screen has to build its own when it is first shown.
+ *
+ * @param context The startup.
+ * @return NULL
+ */
+static void *splashPhase(void *context) {
+    startupStruct *startup = context;
+    decodeSplashScreen();
+    buildScreenTemplates();
+    startupPhaseFinished(startup, STARTUP_SPLASH);
+    return NULL;
+}
+
+/**
+ * The persistence phase, reads the EEPROM image and its journal, opens the feed history and finds the next feed from
+ * the time the clock will start at. A feeder that was off past its next feed would otherwise wait for that time to come
+ * round again.
+ *
+ * @param context The startup.
+ * @return NULL
+ */
+static void *persistencePhase(void *context) {
+    startupStruct *startup = context;
+    readEEPROMImage(startup->eepromFilename, &startup->operatingMode, &startup->warmStartValue);
+    openFeedHistory(&programHistory, startup->historyFilename);
+    if (startup->operatingMode.mode == 0 && startup->operatingMode.numberOfFeedsInADay > 0) {
+        findNextFeedAt(&startup->operatingMode, warmStartMinuteOfDay(startup->warmStartValue));
+    }
+    startupPhaseFinished(startup, STARTUP_PERSISTENCE);
+    return NULL;
+}
+
+/**
+ * Starts the phases that don't need the GUI, this should be called as early as possible so they run while the JVM
+ * starts. The startup must have been set up with PTHREAD_MUTEX_INITIALIZER and PTHREAD_COND_INITIALIZER.
+ *
+ * @param startup The startup to be started.
+ * @param eepromFilename The name of the EEPROM image to be read.
+ * @param historyFilename The name of the feed history to be opened.
+ */
+void startStartup(startupStruct *startup, const char *eepromFilename, const char *historyFilename) {
+    pthread_mutex_lock(&startup->lock);
+    for (int i = 0; i < STARTUP_PHASES; i++) {
+        startup->done[i] = false;
+        startup->doneUs[i] = 0;
+    }
+    pthread_mutex_unlock(&startup->lock);
+    startup->startUs = monotonicUs();
+    startup->eepromFilename = eepromFilename;
+    startup->historyFilename = historyFilename;
+    startup->warmStartValue = 0;
+    pthread_create(&startup->splashThread, NULL, splashPhase, startup);
+    pthread_create(&startup->persistenceThread, NULL, persistencePhase, startup);
+}
+
+/**
+ * Marks a phase as done and wakes the processing thread if it is waiting for it.
+ *
+ * @param startup The startup the phase belongs to.
+ * @param phase The phase that has finished.
+ */
+void startupPhaseFinished(startupStruct *startup, const startupPhase phase) {
+    pthread_mutex_lock(&startup->lock);
+    startup->done[phase] = true;
+    startup->doneUs[phase] = monotonicUs();
+    pthread_cond_broadcast(&startup->phaseDone);
+    pthread_mutex_unlock(&startup->lock);
+}
+
+/**
+ * @param startup The startup the phase belongs to.
+ * @param phase The phase to check.
+ * @return If the phase has finished.
+ */
+bool startupPhaseIsDone(startupStruct *startup, const startupPhase phase) {
+    pthread_mutex_lock(&startup->lock);
+    const bool done = startup->done[phase];
+    pthread_mutex_unlock(&startup->lock);
+    return done;
+}
+
+/**
+ * Waits for a phase to finish. The wait ends as soon as the phase signals, until then the processing thread sleeps
+ * and only wakes to fire the timers of the program timer wheel, so tasks like the splash screen keep running.
+ *
+ * @param startup The startup the phase belongs to.
+ * @param phase The phase to wait for.
+ */
+void startupWaitFor(startupStruct *startup, const startupPhase phase) {
+    pthread_mutex_lock(&startup->lock);
+    while (!startup->done[phase]) {
+        const long long wake = timerWheelNextWakeMs(&programTimers);
+        if (wake < 0) {
+            pthread_cond_wait(&startup->phaseDone, &startup->lock);
+            continue;
+        }
+        //Condition variables wait on the real time clock so the wake up time is converted to it.
+        const long long waitMs = wake - monotonicMs();
+        if (waitMs > 0) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += (time_t) (waitMs / 1000);
+            deadline.tv_nsec += (long) (waitMs % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&startup->phaseDone, &startup->lock, &deadline);
+        }
+        //The timers are fired without holding the lock so a phase finishing isn't held up by drawing.
+        pthread_mutex_unlock(&startup->lock);
+        timerWheelAdvance(&programTimers, monotonicMs());
+        pthread_mutex_lock(&startup->lock);
+    }
+    pthread_mutex_unlock(&startup->lock);
+}
+
+/**
+ * Waits for every phase to finish, then starts the clock and fills the food container with what was read and prints
+ * how long each phase took. Must be called on the processing thread once the GUI is ready.
+ *
+ * @param startup The startup to be finished.
+ * @param operatingMode Set to the operating mode that was read.
+ */
+void finishStartup(startupStruct *startup, operatingModeStruct *operatingMode) {
+    for (int i = 0; i < STARTUP_PHASES; i++) {
+        startupWaitFor(startup, (startupPhase) i);
+    }
+    pthread_join(startup->splashThread, NULL);
+    pthread_join(startup->persistenceThread, NULL);
+    *operatingMode = startup->operatingMode;
+    initialiseProgram(startup->warmStartValue); //Finishes the program startup.
+    const long long readyUs = monotonicUs();
+    printf("Startup: splash decoded %lldms, EEPROM read %lldms, JVM started %lldms, GUI ready %lldms\n",
+           (startup->doneUs[STARTUP_SPLASH] - startup->startUs) / 1000,
+           (startup->doneUs[STARTUP_PERSISTENCE] - startup->startUs) / 1000,
+           (startup->doneUs[STARTUP_JVM] - startup->startUs) / 1000,
+           (startup->doneUs[STARTUP_GUI] - startup->startUs) / 1000);
+    printf("Startup: first frame after %lldms, ready after %lldms\n",
+           (startup->doneUs[STARTUP_FIRST_FRAME] - startup->startUs) / 1000, (readyUs - startup->startUs) / 1000);
+}
@@ -0,0 +1,58 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides the startup pipeline, which gets the program ready to run in phases that overlap.
+*
+* The slow parts of starting up don't depend on each other, so they are started as soon as the program begins instead of
+* one after another. The splash screen is decoded and the screen templates built on one thread and the EEPROM image,
+* its journal and the feed history are read on another while the JVM and GUI start. The first next feed is worked out
+* from the saved clock on the same thread, so nothing on it touches the hardware.
+*
+* Each phase signals when it is done, the processing thread waits for the signal while the event loop keeps the splash
+* screen moving. Once everything is ready the clock is set, the food filled and the splash screen stopped, so it is only
+* shown for as long as starting up takes. How long each phase took is printed, including the time to the first frame,
+* so the time to start can be tracked.
+*/
+#ifndef STARTUP_PIPELINE_HEADER
+#define STARTUP_PIPELINE_HEADER
+#include <pthread.h>
+#include <stdbool.h>
+#include "operatingMode.h"
+
+/**
+ * The phases of starting up, the first two run on their own threads at the same time as the JVM starts.
+ */
+typedef enum {
+    STARTUP_SPLASH, //The splash screen is decoded.
+    STARTUP_PERSISTENCE, //The EEPROM image, journal and feed history are read and the first next feed is found.
+    STARTUP_JVM, //The JVM has been created.
+    STARTUP_GUI, //The GUI is ready to be drawn on.
+    STARTUP_FIRST_FRAME, //The first frame of the splash screen has been drawn.
+    STARTUP_PHASES
+} startupPhase;
+
+/**
+ * The state of the startup, the loaded operating mode can only be used once the persistence phase is done.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t phaseDone; //Signalled each time a phase finishes.
+    bool done[STARTUP_PHASES];
+    long long startUs; //When the program started.
+    long long doneUs[STARTUP_PHASES]; //When each phase finished.
+    pthread_t splashThread;
+    pthread_t persistenceThread;
+    const char *eepromFilename;
+    const char *historyFilename;
+    operatingModeStruct operatingMode; //Read by the persistence phase.
+    long long warmStartValue; //The saved clock value, 0 if there isn't one.
+} startupStruct;
+
+extern startupStruct programStartup; //The startup of the feeder shown on the GUI.
+
+void startStartup(startupStruct *startup, const char *eepromFilename, const char *historyFilename); //Starts the phases.
+void startupPhaseFinished(startupStruct *startup, const startupPhase phase); //Signals that a phase is done.
+bool startupPhaseIsDone(startupStruct *startup, const startupPhase phase);
+void startupWaitFor(startupStruct *startup, const startupPhase phase); //Runs the event loop until the phase is done.
+void finishStartup(startupStruct *startup, operatingModeStruct *operatingMode); //Hands over the loaded operating mode.
+#endif //STARTUP_PIPELINE_HEADER
@@ -0,0 +1,292 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* The hierarchical timer wheel used by the event loop.
+*/
+#include <errno.h>
+#include <stddef.h>
+#include <time.h>
+#include "timerWheel.h"
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+timerWheelStruct programTimers;
+
+/**
+ * Gets the time in milliseconds from the monotonic clock, unlike the RTC this never jumps when the clock is set.
+ *
+ * @return Milliseconds since an arbitrary fixed point.
+ */
+long long monotonicMs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * Gets the time in microseconds from the monotonic clock, for timing that needs to be finer than the wheels ticks.
+ *
+ * @return Microseconds since the same fixed point as monotonicMs.
+ */
+long long monotonicUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * Sleeps until an absolute time on the monotonic clock. Because the time to wake at is fixed, any time spent before the
+ * call or oversleeping on a previous call doesn't push later wake ups back.
+ * macOS has no clock_nanosleep so there the remaining time is slept instead.
+ *
+ * @param deadlineUs The monotonic time in microseconds to wake at.
+ */
+void sleepUntilUs(const long long deadlineUs) {
+#ifdef __APPLE__
+    const long long remainingUs = deadlineUs - monotonicUs();
+    if (remainingUs > 0) {
+        struct timespec remaining = {(time_t) (remainingUs / 1000000), (long) (remainingUs % 1000000) * 1000};
+        nanosleep(&remaining, NULL);
+    }
+#else
+    const struct timespec deadline = {(time_t) (deadlineUs / 1000000), (long) (deadlineUs % 1000000) * 1000};
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+        //Interrupted by a signal, the deadline is absolute so the sleep is simply restarted.
+    }
+#endif
+}
+
+/**
+ * Makes a list head point to itself, meaning the list is empty.
+ *
+ * @param head The sentinel at the head of the list.
+ */
+static void emptyList(timerStruct *head) {
+    head->next = head;
+    head->previous = head;
+}
+
+/**
+ * Adds a timer to the end of a list.
+ *
+ * @param head The sentinel at the head of the list.
+ * @param timer The timer to be added.
+ */
+static void appendToList(timerStruct *head, timerStruct *timer) {
+    timer->next = head;
+    timer->previous = head->previous;
+    head->previous->next = timer;
+    head->previous = timer;
+}
+
+/**
+ * Takes a timer out of whatever list it is in.
+ *
+ * @param timer The timer to be removed.
+ */
+static void removeFromList(timerStruct *timer) {
+    timer->previous->next = timer->next;
+    timer->next->previous = timer->previous;
+    timer->next = NULL;
+    timer->previous = NULL;
+}
+
+/**
+ * Initialises an empty wheel starting at the current time.
+ *
+ * @param wheel The wheel to be initialised.
+ */
+void initialiseTimerWheel(timerWheelStruct *wheel) {
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            emptyList(&wheel->slots[level][slot]);
+        }
+    }
+    wheel->currentTick = 0;
+    wheel->startMs = monotonicMs();
+    wheel->pendingTimers = 0;
+}
+
+/**
+ * Initialises a timer so it can be added to a wheel.
+ *
+ * @param timer The timer to be initialised.
+ * @param callback The function called when the timer expires.
+ * @param context Passed to the callback when it is called.
+ */
+void initialiseTimer(timerStruct *timer, timerCallback callback, void *context) {
+    timer->next = NULL;
+    timer->previous = NULL;
+    timer->expiry = 0;
+    timer->callback = callback;
+    timer->context = context;
+    timer->pending = false;
+}
+
+/**
+ * Puts a timer in the slot matching how far its expiry is from the current tick.
+ * Timers that are due within 64 ticks go in the first level, the further away they are the higher the level.
+ *
+ * @param wheel The wheel the timer is placed in.
+ * @param timer The timer that is placed.
+ */
+static void placeTimer(timerWheelStruct *wheel, timerStruct *timer) {
+    unsigned long long expiry = timer->expiry;
+    if (expiry < wheel->currentTick) {
+        //If it is already due it is put in the slot that will be processed next.
+        expiry = wheel->currentTick;
+    }
+    unsigned long long ticksAway = expiry - wheel->currentTick;
+    int level = 0;
+    //Finds the lowest level that can hold a timer this far away.
+    while (level < TIMER_WHEEL_LEVELS - 1 && ticksAway >= (1ULL << (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    if (ticksAway >= (1ULL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS))) {
+        //Beyond the range of the top level, it will be placed again when that slot cascades.
+        expiry = wheel->currentTick + (1ULL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    }
+    const int slot = (int) ((expiry >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK);
+    appendToList(&wheel->slots[level][slot], timer);
+}
+
+/**
+ * Adds a timer to the wheel, if the timer is already pending it is moved to its new expiry.
+ *
+ * @param wheel The wheel the timer is added to.
+ * @param timer The timer to be added.
+ * @param delayMs How many milliseconds from now the timer should expire.
+ */
+void timerWheelAdd(timerWheelStruct *wheel, timerStruct *timer, const long delayMs) {
+    timerWheelCancel(wheel, timer);
+    const long long dueMs = monotonicMs() + (delayMs > 0 ? delayMs : 0) - wheel->startMs;
+    //Rounds up so a timer never fires early.
+    timer->expiry = (unsigned long long) ((dueMs + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS);
+    timer->pending = true;
+    placeTimer(wheel, timer);
+    wheel->pendingTimers++;
+}
+
+/**
+ * Removes a timer from the wheel so it won't fire. Cancelling a timer that isn't pending does nothing.
+ *
+ * @param wheel The wheel the timer is in.
+ * @param timer The timer to be cancelled.
+ */
+void timerWheelCancel(timerWheelStruct *wheel, timerStruct *timer) {
+    if (timer->pending) {
+        removeFromList(timer);
+        timer->pending = false;
+        wheel->pendingTimers--;
+    }
+}
+
+/**
+ * Moves every timer in a slot of a higher level down into the levels below it.
+ *
+ * @param wheel The wheel being advanced.
+ * @param level The level of the slot being cascaded.
+ * @return The index of the slot that was cascaded, when it is 0 the level above also needs cascading.
+ */
+static int cascade(timerWheelStruct *wheel, const int level) {
+    const int slot = (int) ((wheel->currentTick >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK);
+    timerStruct *head = &wheel->slots[level][slot];
+    timerStruct moving;
+    emptyList(&moving);
+    //Takes the whole list off the slot first because placing a timer may put it back into the same slot.
+    if (head->next != head) {
+        moving.next = head->next;
+        moving.previous = head->previous;
+        moving.next->previous = &moving;
+        moving.previous->next = &moving;
+        emptyList(head);
+    }
+    while (moving.next != &moving) {
+        timerStruct *timer = moving.next;
+        removeFromList(timer);
+        placeTimer(wheel, timer);
+    }
+    return slot;
+}
+
+/**
+ * Processes every tick up to the given time, firing the timers that expire on them.
+ * A callback is allowed to add or cancel any timer including the one that has just fired.
+ *
+ * @param wheel The wheel being advanced.
+ * @param nowMs The current monotonic time in milliseconds.
+ */
+void timerWheelAdvance(timerWheelStruct *wheel, const long long nowMs) {
+    if (nowMs < wheel->startMs) {
+        return;
+    }
+    const unsigned long long targetTick = (unsigned long long) (nowMs - wheel->startMs) / TIMER_WHEEL_TICK_MS;
+    while (wheel->currentTick <= targetTick) {
+        const int slot = (int) (wheel->currentTick & SLOT_MASK);
+        //When the first level wraps around the next slot of each higher level is cascaded down.
+        for (int level = 1; slot == 0 && level < TIMER_WHEEL_LEVELS && cascade(wheel, level) == 0; level++) {
+        }
+        timerStruct *head = &wheel->slots[0][slot];
+        timerStruct expired;
+        emptyList(&expired);
+        if (head->next != head) {
+            expired.next = head->next;
+            expired.previous = head->previous;
+            expired.next->previous = &expired;
+            expired.previous->next = &expired;
+            emptyList(head);
+        }
+        wheel->currentTick++;
+        while (expired.next != &expired) {
+            timerStruct *timer = expired.next;
+            removeFromList(timer);
+            timer->pending = false;
+            wheel->pendingTimers--;
+            timer->callback(timer, timer->context);
+        }
+    }
+}
+
+/**
+ * Finds the next time the wheel has to be advanced. This is the first non-empty slot in the first level or,
+ * if there are only timers in the higher levels, the next time the first level wraps and they are cascaded.
+ *
+ * @param wheel The wheel being checked.
+ * @return The monotonic time in milliseconds the wheel should next be advanced at, or -1 if no timers are pending.
+ */
+long long timerWheelNextWakeMs(const timerWheelStruct *wheel) {
+    if (wheel->pendingTimers == 0) {
+        return -1;
+    }
+    unsigned long long tick = wheel->currentTick;
+    for (int i = 0; i < TIMER_WHEEL_SLOTS; i++, tick++) {
+        const timerStruct *head = &wheel->slots[0][tick & SLOT_MASK];
+        if (head->next != head || (tick & SLOT_MASK) == 0) {
+            break;
+        }
+    }
+    return wheel->startMs + (long long) tick * TIMER_WHEEL_TICK_MS;
+}
+
+/**
+ * Used in place of msleep by the processing thread. Sleeps for the duration given but wakes up to fire any timers
+ * that expire during it, meaning everything registered with the wheel keeps running while a screen waits.
+ *
+ * @param wheel The wheel to dispatch.
+ * @param durationMs How many milliseconds to wait for.
+ */
+void timerWheelRunFor(timerWheelStruct *wheel, const long durationMs) {
+    const long long deadline = monotonicMs() + durationMs;
+    long long now = monotonicMs();
+    do {
+        timerWheelAdvance(wheel, now);
+        long long wake = timerWheelNextWakeMs(wheel);
+        if (wake < 0 || wake > deadline) {
+            wake = deadline;
+        }
+        if (wake > now) {
+            sleepUntilUs(wake * 1000);
+        }
+        now = monotonicMs();
+    } while (now < deadline);
+    timerWheelAdvance(wheel, now);
+}
@@ -0,0 +1,56 @@
+/**
+* Created by Beck Chamberlain on 19/10/2026.
+*
+* This file provides a hierarchical timer wheel that all of the programs timed behaviour registers with.
+*
+* Timers are kept in 5 levels of 64 slots, each slot is a doubly linked list so adding or cancelling a timer is O(1)
+* no matter how many timers are pending. The wheel ticks every millisecond and timers further in the future are cascaded
+* down a level as the wheel turns, the highest level covers just over 12 days.
+*/
+#ifndef TIMER_WHEEL_HEADER
+#define TIMER_WHEEL_HEADER
+#include <stdbool.h>
+
+#define TIMER_WHEEL_TICK_MS 1
+#define TIMER_WHEEL_LEVELS 5
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+
+typedef struct timerStruct timerStruct;
+typedef void (*timerCallback)(timerStruct *timer, void *context); //Called when a timer expires.
+
+/**
+ * A single timer, the struct is owned by whoever adds it to the wheel so no memory is allocated by the wheel.
+ */
+struct timerStruct {
+    timerStruct *next; //The next timer in the same slot.
+    timerStruct *previous; //The previous timer in the same slot.
+    unsigned long long expiry; //The wheel tick the timer expires on.
+    timerCallback callback; //The function called when the timer expires.
+    void *context; //Passed to the callback.
+    bool pending; //If the timer is currently in the wheel.
+};
+
+/**
+ * The timer wheel, slots hold a sentinel timer which is the head of each slots list.
+ */
+typedef struct {
+    timerStruct slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    unsigned long long currentTick; //The next tick that will be processed.
+    long long startMs; //The monotonic time of tick 0.
+    int pendingTimers; //How many timers are in the wheel.
+} timerWheelStruct;
+
+extern timerWheelStruct programTimers; //The wheel driven by the processing threads event loop.
+
+long long monotonicMs(); //Milliseconds from a clock that never jumps.
+long long monotonicUs(); //Microseconds from the same clock.
+void sleepUntilUs(const long long deadlineUs); //Sleeps until an absolute monotonic time.
+void initialiseTimerWheel(timerWheelStruct *wheel);
+void initialiseTimer(timerStruct *timer, timerCallback callback, void *context);
+void timerWheelAdd(timerWheelStruct *wheel, timerStruct *timer, const long delayMs); //Arms (or re-arms) a timer.
+void timerWheelCancel(timerWheelStruct *wheel, timerStruct *timer); //Disarms a timer if it is pending.
+void timerWheelAdvance(timerWheelStruct *wheel, const long long nowMs); //Fires every timer due by nowMs.
+long long timerWheelNextWakeMs(const timerWheelStruct *wheel); //When the wheel next needs advancing, -1 if empty.
+void timerWheelRunFor(timerWheelStruct *wheel, const long durationMs); //Sleeps while dispatching timers.
+#endif //TIMER_WHEEL_HEADER